@@ -323,7 +323,7 @@ static void _signal_handler(const int sig) {
 }
 
 //* Config init
-void init_config(bool low_color, std::optional<std::string>& filter) {
+void init_config(bool low_color, std::optional<std::string>& filter, std::optional<std::string>& scope) {
 	atomic_lock lck(Global::init_conf);
 	vector<string> load_warnings;
 	Config::load(Config::conf_file, load_warnings);
@@ -341,6 +341,10 @@ void init_config(bool low_color, std::optional<std::string>& filter) {
 		Config::set("proc_filter", filter.value());
 	}
 
+	if (scope.has_value()) {
+		Config::set("proc_scope", scope.value());
+	}
+
 	static string log_level;
 	if (const string current_level = Config::getS("log_level"); log_level != current_level) {
 		log_level = current_level;
@@ -493,11 +497,14 @@ namespace Runner {
                 if (debug_bg.empty() or redraw)
                     Runner::debug_bg = Draw::createBox(2, 2, 33,
 					#ifdef GPU_SUPPORT
-						9,
+						11
 					#else
-						8,
+						10
+					#endif
+					#ifdef __linux__
+						+ 1
 					#endif
-					"", true, "μs");
+					, "", true, "μs");
 
 				debug_times.clear();
 				debug_times["total"] = {0, 0};
@@ -644,6 +651,28 @@ namespace Runner {
 					}
 				}
 
+			#ifdef __linux__
+				//? CGROUP
+				if (v_contains(conf.boxes, "cgroup")) {
+					try {
+						if (Global::debug) debug_timer("cgrp", collect_begin);
+
+						//? Start collect
+						auto cgroups = Cgroup::collect(conf.no_update);
+
+						if (Global::debug) debug_timer("cgrp", draw_begin);
+
+						//? Draw box
+						if (not pause_output) output += Cgroup::draw(cgroups, conf.force_redraw, conf.no_update);
+
+						if (Global::debug) debug_timer("cgrp", draw_done);
+					}
+					catch (const std::exception& e) {
+						throw std::runtime_error("Cgroup:: -> " + string{e.what()});
+					}
+				}
+			#endif
+
 			}
 			catch (const std::exception& e) {
 				Global::exit_error_msg = fmt::format("Exception in runner thread -> {}", e.what());
@@ -700,8 +729,12 @@ namespace Runner {
 					"post"_a = Theme::c("main_fg") + Fx::ub
 				);
 				static auto loc = std::locale(std::locale::classic(), new MyNumPunct);
-			#ifdef GPU_SUPPORT
+			#if defined(GPU_SUPPORT) and defined(__linux__)
+				for (const string name : {"cpu", "mem", "net", "proc", "cgrp", "gpu", "total"}) {
+			#elif defined(GPU_SUPPORT)
 				for (const string name : {"cpu", "mem", "net", "proc", "gpu", "total"}) {
+			#elif defined(__linux__)
+				for (const string name : {"cpu", "mem", "net", "proc", "cgrp", "total"}) {
 			#else
 				for (const string name : {"cpu", "mem", "net", "proc", "total"}) {
 			#endif
@@ -715,6 +748,23 @@ namespace Runner {
 						"draw"_a = time_draw
 					);
 				}
+				//? Process history slab, live processes times samples per process and the size of the slab
+				output += fmt::format(loc, "{ub}{mvLD}{name:5.5} {used:>12} {size:>10L}Ki",
+					"ub"_a = Fx::ub,
+					"mvLD"_a = Mv::l(31) + Mv::d(1),
+					"name"_a = "hist",
+					"used"_a = fmt::format("{}x{}", Proc::history.used(), Proc::history_store::samples),
+					"size"_a = Proc::history.bytes() >> 10
+				);
+				//? Syscalls used for reading /proc and context switches during the last process update
+				if (Proc::collect_syscalls >= 0) {
+					output += fmt::format(loc, "{mvLD}{name:5.5} {syscalls:12L} {switches:12L}",
+						"mvLD"_a = Mv::l(31) + Mv::d(1),
+						"name"_a = "sysc",
+						"syscalls"_a = Proc::collect_syscalls.load(),
+						"switches"_a = Proc::collect_switches.load()
+					);
+				}
 			}
 
 			//? If overlay isn't empty, print output without color and then print overlay on top
@@ -933,7 +983,7 @@ static auto configure_tty_mode(std::optional<bool> force_tty) {
 	}
 
 	//? Config init
-	init_config(cli.low_color, cli.filter);
+	init_config(cli.low_color, cli.filter, cli.scope);
 
 	//? Try to find and set a UTF-8 locale
 	if (std::setlocale(LC_ALL, "") != nullptr and not std::string_view { std::setlocale(LC_ALL, "") }.contains(";")
@@ -1096,7 +1146,7 @@ static auto configure_tty_mode(std::optional<bool> force_tty) {
 
 	//? Print out box outlines
 	const bool term_sync = Config::getB("terminal_sync");
-	cout << (term_sync ? Term::sync_start : "") << Cpu::box << Mem::box << Net::box << Proc::box << (term_sync ? Term::sync_end : "") << flush;
+	cout << (term_sync ? Term::sync_start : "") << Cpu::box << Mem::box << Net::box << Proc::box << Cgroup::box << (term_sync ? Term::sync_end : "") << flush;
 
 
 	//? ------------------------------------------------ MAIN LOOP ----------------------------------------------------
@@ -1125,7 +1175,7 @@ static auto configure_tty_mode(std::optional<bool> force_tty) {
 				Global::reload_conf = false;
 				if (Runner::active) Runner::stop();
 				Config::unlock();
-				init_config(cli.low_color, cli.filter);
+				init_config(cli.low_color, cli.filter, cli.scope);
 				Theme::updateThemes();
 				Theme::setTheme();
 				Draw::banner_gen(0, 0, false, true);
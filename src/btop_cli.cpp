@@ -133,6 +133,22 @@ namespace Cli {
 				cli.filter = std::make_optional(arg);
 				continue;
 			}
+			if (arg == "--scope") {
+				// This flag requires an argument.
+				if (++it == args.end()) {
+					error("Scope requires an argument");
+					return std::unexpected { 1 };
+				}
+
+				auto arg = *it;
+				if (not arg.starts_with("cgroup:")
+					and not (arg.starts_with("pid:") and arg.size() > 4 and std::ranges::all_of(arg.substr(4), ::isdigit))) {
+					error("Scope should be cgroup:<path> or pid:<pid>");
+					return std::unexpected { 1 };
+				}
+				cli.scope = std::make_optional(arg);
+				continue;
+			}
 			if (arg == "-p" || arg == "--preset") {
 				// This flag requires an argument.
 				if (++it == args.end()) {
@@ -255,6 +271,7 @@ namespace Cli {
 			"  {2}    --force-utf{1}         Override automatic UTF locale detection\n"
 			"  {2}-l, --low-color{1}         Disable true color, 256 colors only\n"
 			"  {2}-p, --preset{1} <id>       Start with a preset (0-9)\n"
+			"  {2}    --scope{1} <scope>     Only collect processes in cgroup:<path> or below pid:<pid>\n"
 			"  {2}-t, --tty{1}               Force tty mode with ANSI graph symbols and 16 colors only\n"
 			"  {2}    --themes-dir{1} <dir>  Path to a custom themes directory\n"
 			"  {2}    --no-tty{1}            Force disable tty mode\n"
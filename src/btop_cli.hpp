@@ -28,6 +28,8 @@ namespace Cli {
 		bool low_color {};
 		// Start with one of the provided presets
 		std::optional<std::uint32_t> preset;
+		// Only collect processes in a cgroup or below a pid
+		std::optional<std::string> scope;
 		// Path to a custom themes directory
 		std::optional<stdfs::path> themes_dir;
 		// The initial refresh rate
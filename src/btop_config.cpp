@@ -100,17 +100,22 @@ namespace Config {
 
 		{"graph_symbol_proc", 	"# Graph symbol to use for graphs in cpu box, \"default\", \"braille\", \"block\" or \"tty\"."},
 
-		{"shown_boxes", 		"#* Manually set which boxes to show. Available values are \"cpu mem net proc\" and \"gpu0\" through \"gpu5\", separate values with whitespace."},
+		{"shown_boxes", 		"#* Manually set which boxes to show. Available values are \"cpu mem net proc\" and \"gpu0\" through \"gpu5\", separate values with whitespace.\n"
+								"#* (Linux) \"cgroup\" shows cpu, memory and io usage of control groups below the proc box."},
 
 		{"update_ms", 			"#* Update time in milliseconds, recommended 2000 ms or above for better sample times for graphs."},
 
 		{"proc_sorting",		"#* Processes sorting, \"pid\" \"program\" \"arguments\" \"threads\" \"user\" \"memory\" \"cpu lazy\" \"cpu direct\",\n"
-								"#* \"cpu lazy\" sorts top process over time (easier to follow), \"cpu direct\" updates top process directly."},
+								"#* \"io read\" \"io write\" \"minor faults\" \"major faults\", \"cpu lazy\" sorts top process over time (easier to follow),\n"
+								"#* \"cpu direct\" updates top process directly. \"io read\" and \"io write\" need proc_io enabled (Linux),\n"
+								"#* \"minor faults\" and \"major faults\" by page faults per second and need proc_faults enabled (Linux)."},
 
 		{"proc_reversed",		"#* Reverse sorting order, True or False."},
 
 		{"proc_tree",			"#* Show processes as a tree."},
 
+		{"proc_group",			"#* (Linux) Show one row per program with the summed cpu, memory and threads of its processes, not used in tree view or thread mode."},
+
 		{"proc_colors", 		"#* Use the cpu graph colors in the process list."},
 
 		{"proc_gradient", 		"#* Use a darkening gradient in the process list."},
@@ -127,6 +132,49 @@ namespace Config {
 
 		{"proc_filter_kernel",  "#* (Linux) Filter processes tied to the Linux kernel(similar behavior to htop)."},
 
+		{"proc_filter_index",	"#* (Linux) Keep a trigram index of process pids, names, commands and users while a filter is set and for a minute after it's cleared.\n"
+								"#* Substring filters then only check processes containing the substring, uses memory in proportion to the length of all command lines."},
+
+		{"proc_scope",			"#* (Linux) Only collect processes in a cgroup and the cgroups below it, \"cgroup:<path>\" with the path relative to the cgroup v2 mount,\n"
+								"#* or a process and its descendants, \"pid:<pid>\". Empty to collect all processes. Collection cost scales with the size of the scope."},
+
+		{"proc_scope_boxes",	"#* (Linux) With a cgroup proc_scope, show the cpu and memory usage of the cgroup in the cpu and mem boxes instead of the whole system."},
+
+		{"proc_events",			"#* (Linux) Track process starts and exits with the kernel proc connector instead of scanning /proc for new pids every update.\n"
+								"#* Cpu time of processes that exit between updates is added to their parent. Requires root or CAP_NET_ADMIN."},
+
+		{"proc_workers",		"#* (Linux) Number of threads used to read process information from /proc, 0 to use one thread per cpu core.\n"
+								"#* Values above 1 can reduce the time spent collecting on systems with many processes and cores."},
+
+		{"proc_fd_budget",		"#* (Linux) Percent of the soft open file limit used for keeping /proc/[pid]/stat open between updates, 0 to disable.\n"
+								"#* Cached files are re-read with a single pread() instead of open, read and close. Each open file uses a few KiB of kernel memory."},
+
+		{"proc_io_uring",		"#* (Linux) Read /proc/[pid]/stat of many processes with a single io_uring submission instead of separate open, read and close calls.\n"
+								"#* Requires kernel 5.15 or newer, falls back to normal reads if io_uring is unavailable or blocked."},
+
+		{"proc_schedstat",		"#* (Linux) Calculate process cpu usage from nanosecond run times in /proc/[pid]/schedstat instead of clock ticks in /proc/[pid]/stat.\n"
+								"#* Accurate at low update_ms values and adds a Wait% column with time spent waiting for a free cpu. Reads one more file per process."},
+
+		{"proc_io",				"#* (Linux) Show Rd/s and Wr/s columns with the storage read and write rates of each process from /proc/[pid]/io.\n"
+								"#* Reads one more file per process, processes of other users can only be read as root."},
+
+		{"proc_io_interval",	"#* (Linux) Read /proc/[pid]/io only every N updates when proc_io is enabled, rates are averaged over the time between reads."},
+
+		{"proc_faults",			"#* (Linux) Show MinF/s and MajF/s columns with the minor and major page faults per second of each process, read from /proc/[pid]/stat."},
+
+		{"proc_pss",			"#* (Linux) Show Pss, Uss and Swap columns from /proc/[pid]/smaps_rollup, which count shared memory fairly unlike the rss from stat.\n"
+								"#* Read round-robin by a low priority background thread, values of large process lists fill in over several updates."},
+
+		{"proc_pss_budget",		"#* (Linux) Milliseconds the proc_pss background thread spends reading smaps_rollup per update."},
+
+		{"proc_cold_interval",	"#* (Linux) Read processes whose cpu time and memory didn't change for 5 updates only every N updates, 0 to disable.\n"
+								"#* Idle processes may show values up to N updates old, the share of cpu time shown late is displayed in the process box."},
+
+		{"proc_threads",		"#* (Linux) Show each thread of multithreaded processes as its own row in the process list, not used in tree view.\n"
+								"#* Thread directories are only read again when the thread count or cpu time of the process changed."},
+
+		{"cgroup_sorting",		"#* (Linux) Sorting of groups in the cgroup box, \"cpu\" \"memory\" or \"io\", groups are sorted among their siblings."},
+
 		{"proc_follow_detailed",	"#* Should the process list follow the selected process when detailed view is open."},
 
 		{"proc_aggregate",		"#* In tree-view, always accumulate child process resources in the parent process."},
@@ -264,6 +312,7 @@ namespace Config {
 		{"graph_symbol_net", "default"},
 		{"graph_symbol_proc", "default"},
 		{"proc_sorting", "cpu lazy"},
+		{"cgroup_sorting", "cpu"},
 		{"cpu_graph_upper", "Auto"},
 		{"cpu_graph_lower", "Auto"},
 		{"cpu_sensor", "Auto"},
@@ -281,6 +330,7 @@ namespace Config {
 		{"base_10_bitrate", "Auto"},
 		{"log_level", "WARNING"},
 		{"proc_filter", ""},
+		{"proc_scope", ""},
 		{"proc_command", ""},
 		{"selected_name", ""},
 	#ifdef GPU_SUPPORT
@@ -302,6 +352,7 @@ namespace Config {
 		{"rounded_corners", true},
 		{"proc_reversed", false},
 		{"proc_tree", false},
+		{"proc_group", false},
 		{"proc_colors", true},
 		{"proc_gradient", true},
 		{"proc_per_core", false},
@@ -310,6 +361,15 @@ namespace Config {
 		{"proc_info_smaps", false},
 		{"proc_left", false},
 		{"proc_filter_kernel", false},
+		{"proc_filter_index", false},
+		{"proc_scope_boxes", true},
+		{"proc_events", false},
+		{"proc_threads", false},
+		{"proc_io_uring", false},
+		{"proc_schedstat", false},
+		{"proc_io", false},
+		{"proc_faults", false},
+		{"proc_pss", false},
 		{"cpu_invert_lower", true},
 		{"cpu_single_graph", false},
 		{"cpu_bottom", false},
@@ -368,6 +428,11 @@ namespace Config {
 		{"net_download", 100},
 		{"net_upload", 100},
 		{"proc_tree_auto_collapse", 0},
+		{"proc_workers", 1},
+		{"proc_fd_budget", 25},
+		{"proc_cold_interval", 0},
+		{"proc_io_interval", 1},
+		{"proc_pss_budget", 20},
 		{"detailed_pid", 0},
 		{"restore_detailed_pid", 0},
 		{"selected_pid", 0},
@@ -568,6 +633,24 @@ namespace Config {
 		else if (name == "proc_tree_auto_collapse" and i_value > 10000)
 			validError = "Config value proc_tree_auto_collapse set too high (>10000).";
 
+		else if (name == "proc_fd_budget" and (i_value < 0 or i_value > 90))
+			validError = "Config value proc_fd_budget set to out of range value (0 to 90).";
+
+		else if (name == "proc_cold_interval" and (i_value < 0 or i_value > 60))
+			validError = "Config value proc_cold_interval set to out of range value (0 to 60).";
+
+		else if (name == "proc_io_interval" and (i_value < 1 or i_value > 60))
+			validError = "Config value proc_io_interval set to out of range value (1 to 60).";
+
+		else if (name == "proc_pss_budget" and (i_value < 1 or i_value > 1000))
+			validError = "Config value proc_pss_budget set to out of range value (1 to 1000).";
+
+		else if (name == "proc_workers" and i_value < 0)
+			validError = "Config value proc_workers must be >= 0.";
+
+		else if (name == "proc_workers" and i_value > 256)
+			validError = "Config value proc_workers set too high (>256).";
+
 		else
 			return true;
 
@@ -605,6 +688,21 @@ namespace Config {
 			validError = "Invalid value for show_gpu_info: " + value;
 	#endif
 
+		else if (name == "proc_sorting" and not v_contains(Proc::sort_vector, value))
+			validError = "Invalid proc_sorting: " + value;
+
+	#ifndef __linux__
+		else if (name == "proc_sorting" and is_in(value, "io read", "io write", "minor faults", "major faults"))
+			validError = "proc_sorting \"" + value + "\" is only available on Linux.";
+	#endif
+
+		else if (name == "cgroup_sorting" and not v_contains(Cgroup::sort_vector, value))
+			validError = "Invalid cgroup_sorting: " + value;
+
+		else if (name == "proc_scope" and not value.empty() and not value.starts_with("cgroup:")
+			and not (value.starts_with("pid:") and value.size() > 4 and isint(std::string_view{value}.substr(4))))
+			validError = "Invalid proc_scope, should be \"cgroup:<path>\" or \"pid:<pid>\": " + value;
+
 		else if (name == "presets" and not presetsValid(value))
 			return false;
 
@@ -811,6 +909,12 @@ namespace Config {
 				cread.ignore(SSmax, '\n');
 			}
 
+			//? Sorting by a column that isn't collected, checked after loading since the option enabling it can come later in the file
+			if (not Proc::sort_available(strings.at("proc_sorting"))) {
+				load_warnings.push_back("proc_sorting \"" + strings.at("proc_sorting") + "\" needs its column enabled, using \"cpu lazy\".");
+				strings.at("proc_sorting") = "cpu lazy";
+			}
+
 			if (not load_warnings.empty()) write_new = true;
 		}
 	}
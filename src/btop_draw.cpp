@@ -1318,7 +1318,8 @@ namespace Mem {
 		string up = (graph_height >= 2 ? Mv::l(mem_width - 2) + Mv::u(graph_height - 1) : "");
 		bool big_mem = mem_width > 21;
 
-		out += Mv::to(y + 1, x + 2) + Theme::c("title") + Fx::b + "Total:" + rjust(floating_humanizer(totalMem), mem_width - 9) + Fx::ub + Theme::c("main_fg");
+		out += Mv::to(y + 1, x + 2) + Theme::c("title") + Fx::b + (mem.scope_total > 0 ? "Limit:" : "Total:")
+			+ rjust(floating_humanizer(mem.scope_total > 0 ? mem.scope_total : totalMem), mem_width - 9) + Fx::ub + Theme::c("main_fg");
 		vector<string> comb_names (mem_names.begin(), mem_names.end());
 		if (show_swap and has_swap and not swap_disk) comb_names.insert(comb_names.end(), swap_names.begin(), swap_names.end());
 		for (const auto& name : comb_names) {
@@ -1586,7 +1587,7 @@ namespace Proc {
 	Draw::TextEdit filter;
 	Draw::Graph detailed_cpu_graph;
 	Draw::Graph detailed_mem_graph;
-	int user_size, thread_size, prog_size, cmd_size, tree_size;
+	int user_size, thread_size, wait_size, io_size, fault_size, pss_size, prog_size, cmd_size, tree_size;
 	int dgraph_x, dgraph_width, d_width, d_x, d_y;
 	bool previous_proc_banner_state = false;
 	atomic<bool> resized (false);
@@ -1676,6 +1677,7 @@ namespace Proc {
 	string draw(const vector<proc_info>& plist, bool force_redraw, bool data_same) {
 		if (Runner::stopping) return "";
 		auto proc_tree = Config::getB("proc_tree");
+		const bool group_rows = Proc::group_mode();
 		bool show_detailed = (Config::getB("show_detailed") and cmp_equal(Proc::detailed.last_pid, Config::getI("detailed_pid")));
 		bool proc_gradient = (Config::getB("proc_gradient") and not Config::getB("lowcolor") and Theme::gradients.contains("proc"));
 		auto proc_colors = Config::getB("proc_colors");
@@ -1685,6 +1687,7 @@ namespace Proc {
 		auto mem_bytes = Config::getB("proc_mem_bytes");
 		auto vim_keys = Config::getB("vim_keys");
 		auto show_graphs = Config::getB("proc_cpu_graphs");
+		auto per_core = Config::getB("proc_per_core");
 		const auto pause_proc_list = Config::getB("pause_proc_list");
 		auto follow_process = Config::getB("follow_process");
 		int followed_pid = Config::getI("followed_pid");
@@ -1769,7 +1772,7 @@ namespace Proc {
 			const string title_right = Theme::c("proc_box") + Symbols::title_right;
 			const string title_left_down = Theme::c("proc_box") + Symbols::title_left_down;
 			const string title_right_down = Theme::c("proc_box") + Symbols::title_right_down;
-			for (const auto& key : {"t", "K", "k", "s", "N", "F", "enter", "info_enter"})
+			for (const auto& key : {"t", "K", "k", "s", "N", "F", "g", "enter", "info_enter"})
 				if (Input::mouse_mappings.contains(key)) Input::mouse_mappings.erase(key);
 
 			//? Adapt sizes of text fields
@@ -1782,6 +1785,26 @@ namespace Proc {
 				cmd_size += 5;
 				tree_size += 5;
 			}
+			wait_size = (Config::getB("proc_schedstat") and width >= 80 ? 5 : 0);
+			if (wait_size > 0) {
+				cmd_size -= wait_size + 1;
+				tree_size -= wait_size + 1;
+			}
+			io_size = (Config::getB("proc_io") and width >= 90 ? 5 : 0);
+			if (io_size > 0) {
+				cmd_size -= (io_size + 1) * 2;
+				tree_size -= (io_size + 1) * 2;
+			}
+			fault_size = (Config::getB("proc_faults") and width >= 90 ? 6 : 0);
+			if (fault_size > 0) {
+				cmd_size -= (fault_size + 1) * 2;
+				tree_size -= (fault_size + 1) * 2;
+			}
+			pss_size = (Config::getB("proc_pss") and width >= 100 ? 5 : 0);
+			if (pss_size > 0) {
+				cmd_size -= (pss_size + 1) * 3;
+				tree_size -= (pss_size + 1) * 3;
+			}
 
 			//? Detailed box
 			if (show_detailed) {
@@ -1856,7 +1879,7 @@ namespace Proc {
 				out += Mv::to(d_y + 5 + i++, d_x + 1) + l;
 
 				out += Theme::c("main_fg") + Fx::ub;
-				const auto san_cmd = replace_ascii_control(detailed.entry.cmd);
+				const auto san_cmd = (detailed.entry.unreadable ? "<unreadable> " : "") + replace_ascii_control(detailed.entry.cmd);
 				const int cmd_size = ulen(san_cmd, true);
 				for (int num_lines = min(3, (int)ceil((double)cmd_size / (d_width - 5))), i = 0; i < num_lines; i++) {
 					out += Mv::to(d_y + 5 + (num_lines == 1 ? 1 : i), d_x + 3)
@@ -1867,7 +1890,13 @@ namespace Proc {
 
 			//? Filter
 			auto filtering = Config::getB("proc_filtering"); // ? filter(20) : Config::getS("proc_filter"))
-			const auto filter_text = (filtering) ? filter(max(6, width - 66)) : uresize(Config::getS("proc_filter"), max(6, width - 66));
+		#ifdef __linux__
+			const bool show_group_button = width > 90;
+		#else
+			const bool show_group_button = false;
+		#endif
+			const int filter_width = max(6, width - (show_group_button ? 76 : 66));
+			const auto filter_text = (filtering) ? filter(filter_width) : uresize(Config::getS("proc_filter"), filter_width);
 			out += Mv::to(y, x+9) + title_left + (not filter_text.empty() ? Fx::b : "") + Theme::c("hi_fg") + 'f'
 				+ Theme::c("title") + (not filter_text.empty() ? ' ' + filter_text : "ilter")
 				+ (not filtering and not filter_text.empty() ? Theme::c("hi_fg") + " del" : "")
@@ -1881,11 +1910,17 @@ namespace Proc {
 					Input::mouse_mappings["delete"] = {y, x + 11 + f_len, 1, 3};
 			}
 
-			//? pause, per-core, reverse, tree and sorting
+			//? group, pause, per-core, reverse, tree and sorting
 			const auto& sorting = Config::getS("proc_sorting");
 			const int sort_len = sorting.size();
 			const int sort_pos = x + width - sort_len - 8;
 
+			if (show_group_button) {
+				out += Mv::to(y, sort_pos - 40) + title_left + (Config::getB("proc_group") ? Fx::b : "") + Theme::c("hi_fg")
+					+ 'g' + Theme::c("title") + "roup" + Fx::ub + title_right;
+				if (not vim_keys) Input::mouse_mappings["g"] = {y, sort_pos - 39, 1, 5};
+			}
+
 			if (width > 60 + sort_len) {
 			    fmt::format_to(std::back_inserter(out), "{}{}{}{}{}{}{}{}{}{}{}",
 					Mv::to(y, sort_pos - 32), title_left, pause_proc_list ? Fx::b : "",
@@ -1951,7 +1986,7 @@ namespace Proc {
 			//? Labels for fields in list
 			if (not proc_tree)
 				out += Mv::to(y+1, x+1) + Theme::c("title") + Fx::b
-					+ rjust("Pid:", 8) + ' '
+					+ rjust((group_rows ? "Procs:" : "Pid:"), 8) + ' '
 					+ ljust("Program:", prog_size) + ' '
 					+ (cmd_size > 0 ? ljust("Command:", cmd_size) : "") + ' ';
 			else
@@ -1960,6 +1995,10 @@ namespace Proc {
 
 			out += (thread_size > 0 ? Mv::l(4) + "Threads: " : "")
 					+ ljust("User:", user_size) + ' '
+					+ (wait_size > 0 ? rjust("Wait%", wait_size) + ' ' : "")
+					+ (io_size > 0 ? rjust("Rd/s", io_size) + ' ' + rjust("Wr/s", io_size) + ' ' : "")
+					+ (fault_size > 0 ? rjust("MinF/s", fault_size) + ' ' + rjust("MajF/s", fault_size) + ' ' : "")
+					+ (pss_size > 0 ? rjust("Pss", pss_size) + ' ' + rjust("Uss", pss_size) + ' ' + rjust("Swap", pss_size) + ' ' : "")
 					+ rjust((mem_bytes ? "MemB" : "Mem%"), 5) + ' '
 					+ rjust("Cpu%", (show_graphs ? 10 : 5)) + Fx::ub;
 		}
@@ -1991,6 +2030,15 @@ namespace Proc {
 			if (item_fit >= 7) out += cjust(to_string(detailed.entry.threads), item_width);
 			if (item_fit >= 8) out += cjust(to_string(detailed.entry.p_nice), item_width);
 
+			//? Busiest threads of the process, as many as fits on one line
+			string top_threads;
+			for (const auto& t : detailed.top_threads) {
+				string thread_str = fmt::format("{} {:.1f}% {}  ", t.name.str(), t.cpu_p, t.state);
+				if (cmp_greater(ulen(top_threads) + ulen(thread_str) + 9, d_width - 2)) break;
+				top_threads += thread_str;
+			}
+			out += Mv::to(d_y + 3, d_x + 1) + (top_threads.empty() ? "" : Theme::c("title") + Fx::b + "Threads: " + Fx::ub + Theme::c("main_fg"))
+				+ ljust(top_threads, d_width - 2 - (top_threads.empty() ? 0 : 9));
 
 			const double mem_p = detailed.mem_bytes.back() * 100.0 / totalMem;
 			string mem_str = fmt::format("{:.2f}", mem_p);
@@ -2028,7 +2076,15 @@ namespace Proc {
 			bool has_graph = show_graphs ? p_counters.contains(p.pid) : false;
 			if (show_graphs and ((p.cpu_p > 0 and not has_graph) or (not data_same and has_graph))) {
 				if (not has_graph) {
-					p_graphs[p.pid] = Draw::Graph{5, 1, "", {}, graph_symbol};
+					//? Start from the recorded history, the latest sample is added when drawing the line below
+					deque<long long> cpu_history;
+					history.cpu(p.pid, cpu_history, 11);
+					if (not cpu_history.empty()) cpu_history.pop_back();
+					for (auto& value : cpu_history) {
+						const double cpu_p = per_core ? value : (double)value / Shared::coreCount;
+						value = (cpu_p >= 0.1 and cpu_p < 5 ? 5ll : (long long)round(cpu_p));
+					}
+					p_graphs[p.pid] = Draw::Graph{5, 1, "", cpu_history, graph_symbol};
 					p_counters[p.pid] = 0;
 				}
 				else if (p.cpu_p < 0.1 and ++p_counters[p.pid] >= 10) {
@@ -2074,14 +2130,15 @@ namespace Proc {
 				}
 			}
 
-			const auto san_cmd = replace_ascii_control(p.cmd);
+			//? Processes whose command line couldn't be read in time show their last known command
+			const auto san_cmd = (p.unreadable ? "<unreadable> " : "") + replace_ascii_control(p.cmd);
 
 			if (not p_wide_cmd.contains(p.pid)) p_wide_cmd[p.pid] = ulen(san_cmd) != ulen(san_cmd, true);
 
 			//? Normal view line
 			if (not proc_tree) {
 				out += Mv::to(y+2+lc, x+1)
-					+ g_color + rjust(to_string(p.pid), 8) + ' '
+					+ g_color + rjust(to_string(p.group_size > 0 ? p.group_size : p.pid), 8) + ' '
 					+ c_color + ljust(p.name, prog_size, true) + ' ' + end
 					+ (cmd_size > 0 ? g_color + ljust(san_cmd, cmd_size, true, p_wide_cmd[p.pid]) + Mv::to(y+2+lc, x+11+prog_size+cmd_size) + ' ' : "");
 			}
@@ -2113,6 +2170,31 @@ namespace Proc {
 				if (cpu_str.ends_with('.')) cpu_str.pop_back();
 				cpu_str += "k";
 			}
+			string wait_str;
+			if (wait_size > 0) {
+				wait_str = (p.wait_p < 0.1 ? "0" : fmt::format("{:.1f}", p.wait_p));
+				if (wait_str.size() > 4) wait_str.resize(4);
+				if (wait_str.ends_with('.')) wait_str.pop_back();
+			}
+			string io_read_str, io_write_str;
+			if (io_size > 0) {
+				io_read_str = (p.io_read_s < 1.0 ? "0" : floating_humanizer(static_cast<uint64_t>(p.io_read_s), true));
+				io_write_str = (p.io_write_s < 1.0 ? "0" : floating_humanizer(static_cast<uint64_t>(p.io_write_s), true));
+			}
+			//? Fault rates above 99999 per second are shortened to thousands, 123456 -> 123K
+			string fault_str;
+			if (fault_size > 0) {
+				for (const auto rate : {p.minflt_s, p.majflt_s}) {
+					const auto faults = static_cast<uint64_t>(round(rate));
+					fault_str += rjust(faults > 99'999 ? to_string(faults / 1000) + 'K' : to_string(faults), fault_size) + ' ';
+				}
+			}
+			//? Processes not sampled yet or whose smaps_rollup can't be read have no pss
+			string pss_str;
+			if (pss_size > 0) {
+				for (const auto value : {p.pss, p.uss, p.swap})
+					pss_str += rjust(not p.rollup_sampled ? "-" : value == 0 ? "0" : floating_humanizer(value, true), pss_size) + ' ';
+			}
 			string mem_str = (mem_bytes ? floating_humanizer(p.mem, true) : "");
 			if (not mem_bytes) {
 				double mem_p = clamp((double)p.mem * 100 / totalMem, 0.0, 100.0);
@@ -2133,6 +2215,10 @@ namespace Proc {
 
 			out += (thread_size > 0 ? t_color + rjust(proc_threads_string, thread_size) + ' ' + end : "" )
 				+ g_color + ljust((cmp_greater(p.user.size(), user_size) ? p.user.substr(0, user_size - 1) + '+' : p.user), user_size) + ' '
+				+ (wait_size > 0 ? c_color + rjust(wait_str, wait_size) + end + ' ' : "")
+				+ (io_size > 0 ? g_color + rjust(io_read_str, io_size) + ' ' + rjust(io_write_str, io_size) + ' ' : "")
+				+ (fault_size > 0 ? m_color + fault_str + end : "")
+				+ (pss_size > 0 ? m_color + pss_str + end : "")
 				+ m_color + rjust(mem_str, 5) + end + ' '
 				+ (is_selected or is_followed ? "" : Theme::c("inactive_fg")) + (show_graphs ? graph_bg * 5: "")
 				+ (p_graphs.contains(p.pid) ? Mv::l(5) + c_color + p_graphs.at(p.pid)({(p.cpu_p >= 0.1 and p.cpu_p < 5 ? 5ll : (long long)round(p.cpu_p))}, data_same) : "") + end + ' '
@@ -2173,6 +2259,25 @@ namespace Proc {
 		out += Mv::to(y + height - 1, x+width - 3 - max(9, (int)location.size())) + Fx::ub + Theme::c("proc_box") + loc_clear
 			+ Symbols::title_left_down + Theme::c("title") + Fx::b + location + Fx::ub + Theme::c("proc_box") + Symbols::title_right_down;
 
+		//? Number of processes that exited since last update, only available if the collector is tracking process exits
+		int title_end = x + width - 3 - max(9, (int)location.size());
+		if (const int exited = Proc::exited_procs; exited >= 0 and width > 90) {
+			string exits = "exited " + to_string(exited);
+			string exits_clear = Symbols::h_line * max(0, 11 - (int)exits.size());
+			title_end -= 2 + max(11, (int)exits.size());
+			out += Mv::to(y + height - 1, title_end) + Theme::c("proc_box") + exits_clear
+				+ Symbols::title_left_down + Theme::c("title") + Fx::b + exits + Fx::ub + Theme::c("proc_box") + Symbols::title_right_down;
+		}
+
+		//? Processes in the cold tier and the share of cpu time they showed late, only available if tiering is enabled
+		if (const int cold = Proc::cold_procs; cold >= 0 and width > 110) {
+			const string tier = fmt::format("cold {} late {:.1f}%", cold, Proc::stale_cpu.load());
+			string tier_clear = Symbols::h_line * max(0, 24 - (int)tier.size());
+			title_end -= 2 + max(24, (int)tier.size());
+			out += Mv::to(y + height - 1, title_end) + Theme::c("proc_box") + tier_clear
+				+ Symbols::title_left_down + Theme::c("title") + Fx::b + tier + Fx::ub + Theme::c("proc_box") + Symbols::title_right_down;
+		}
+
 		//? Clear out left over graphs from dead processes at a regular interval
 		if (not data_same and ++counter >= 100) {
 			counter = 0;
@@ -2213,6 +2318,73 @@ namespace Proc {
 
 }
 
+namespace Cgroup {
+	int height_p = 35;
+	int min_width = 44, min_height = 6;
+	int x = 1, y, width = 20, height;
+	bool shown = false, redraw = true;
+	string box;
+
+	string draw(const cgroup_stats& stats, bool force_redraw, bool /*data_same*/) {
+		if (Runner::stopping) return "";
+		if (force_redraw) redraw = true;
+		const auto& sorting = Config::getS("cgroup_sorting");
+		const string title_left = Theme::c("proc_box") + Fx::ub + Symbols::title_left;
+		const string title_right = Theme::c("proc_box") + Fx::ub + Symbols::title_right;
+		const bool show_io = width >= 64;
+		const bool show_split = width >= 80;
+		const int name_width = width - 2 - 7 - 8 - (show_split ? 16 : 0) - (show_io ? 20 : 0);
+		const int rows = height - 3;
+		string out;
+		out.reserve(width * height);
+
+		//* Redraw elements not needed to be updated every cycle
+		if (redraw) {
+			out = box;
+			out += Mv::to(y + 1, x + 1) + Theme::c("title") + Fx::b + ljust("Group", name_width) + rjust("Cpu%", 7) + rjust("Mem", 8)
+				+ (show_split ? rjust("Anon", 8) + rjust("File", 8) : "") + (show_io ? rjust("Read/s", 10) + rjust("Write/s", 10) : "") + Fx::ub;
+		}
+		out += Mv::to(y, x + width - 12) + Theme::c("proc_box") + Symbols::h_line * 10
+			+ Mv::to(y, x + width - sorting.size() - 4) + title_left + Fx::b + Theme::c("title") + sorting + title_right;
+
+		if (not stats.available) {
+			out += Mv::to(y + 2, x + 1) + Theme::c("inactive_fg") + ljust("No cgroup v2 hierarchy found", width - 2);
+			redraw = false;
+			return out + Fx::reset;
+		}
+
+		//? Groups, indented by depth below their parent
+		for (int i = 0; i < rows; i++) {
+			out += Mv::to(y + 2 + i, x + 1);
+			if (cmp_less_equal(stats.groups.size(), i)) {
+				out += string(width - 2, ' ');
+				continue;
+			}
+			const auto& group = stats.groups.at(i);
+			const auto humanize = [](bool has, uint64_t value, bool per_second = false) {
+				return has ? floating_humanizer(value, true, 0, false, per_second) : "-"s;
+			};
+			const string cpu_str = group.cpu_p < 10 ? fmt::format("{:.1f}", group.cpu_p) : fmt::format("{:.0f}", group.cpu_p);
+			out += Theme::c("main_fg") + ljust(string(min(group.depth, (size_t)8) * 2, ' ') + group.name, name_width)
+				+ Theme::g("cpu").at(clamp((int)round(group.cpu_p), 0, 100)) + rjust(cpu_str, 7)
+				+ Theme::c("main_fg") + rjust(humanize(group.has_mem, group.mem), 8);
+			if (show_split)
+				out += rjust(humanize(group.has_mem, group.anon), 8) + rjust(humanize(group.has_mem, group.file), 8);
+			if (show_io)
+				out += rjust(humanize(group.has_io, group.io_read, true), 10) + rjust(humanize(group.has_io, group.io_write, true), 10);
+		}
+
+		//? Number of groups not fitting in the box
+		out += Mv::to(y + height - 1, x + 1) + Theme::c("proc_box") + Symbols::h_line * 16;
+		if (cmp_greater(stats.groups.size(), rows))
+			out += Mv::to(y + height - 1, x + 1) + title_left + Theme::c("main_fg") + fmt::format("+{} groups", stats.groups.size() - rows) + title_right;
+
+		redraw = false;
+		return out + Fx::reset;
+	}
+
+}
+
 namespace Draw {
 	void calcSizes() {
 		atomic_wait(Runner::active);
@@ -2227,6 +2399,7 @@ namespace Draw {
 		Mem::box.clear();
 		Net::box.clear();
 		Proc::box.clear();
+		Cgroup::box.clear();
 		Global::clock.clear();
 		Global::overlay.clear();
 		Runner::pause_output = false;
@@ -2244,6 +2417,9 @@ namespace Draw {
 		Cpu::width = Mem::width = Net::width = Proc::width = 0;
 		Cpu::height = Mem::height = Net::height = Proc::height = 0;
 		Cpu::redraw = Mem::redraw = Net::redraw = Proc::redraw = true;
+		Cgroup::x = Cgroup::y = 1;
+		Cgroup::width = Cgroup::height = 0;
+		Cgroup::redraw = true;
 
 		Cpu::shown = boxes.contains("cpu");
 	#ifdef GPU_SUPPORT
@@ -2271,6 +2447,9 @@ namespace Draw {
 		Mem::shown = boxes.contains("mem");
 		Net::shown = boxes.contains("net");
 		Proc::shown = boxes.contains("proc");
+		Cgroup::shown = boxes.contains("cgroup");
+		//? The cgroup box shares the right hand column with the proc box
+		const bool proc_column = Proc::shown or Cgroup::shown;
 
 		//* Calculate and draw cpu box outlines
 		if (Cpu::shown) {
@@ -2285,7 +2464,7 @@ namespace Draw {
             const bool show_temp = (Config::getB("check_temp") and got_sensors);
 			width = round((double)Term::width * width_p / 100);
 		#ifdef GPU_SUPPORT
-			if (Gpu::shown != 0 and not (Mem::shown or Net::shown or Proc::shown)) {
+			if (Gpu::shown != 0 and not (Mem::shown or Net::shown or proc_column)) {
 				height = Term::height - Gpu::total_height - gpus_extra_height;
 			} else {
 				height = max(8, (int)ceil((double)Term::height * (trim(boxes) == "cpu" ? 100 : height_p/(Gpu::shown+1) + (Gpu::shown != 0)*5) / 100));
@@ -2366,11 +2545,11 @@ namespace Draw {
 				int height = 0;
 				width = Term::width;
 				if (Cpu::shown)
-					if (not (Mem::shown or Net::shown or Proc::shown))
+					if (not (Mem::shown or Net::shown or proc_column))
 						height = min_height;
 					else height = Cpu::height;
 				else
-					if (not (Mem::shown or Net::shown or Proc::shown))
+					if (not (Mem::shown or Net::shown or proc_column))
 						height = (Term::height - total_height) / (Gpu::shown - i) + (i == 0) * ((Term::height - total_height) % (Gpu::shown - i));
 					else
 						height = max(min_height, (int)ceil((double)Term::height * height_p/Gpu::shown / 100));
@@ -2403,13 +2582,13 @@ namespace Draw {
 			auto swap_disk = Config::getB("swap_disk");
 			auto mem_graphs = Config::getB("mem_graphs");
 
-			width = round((double)Term::width * (Proc::shown ? width_p : 100) / 100);
+			width = round((double)Term::width * (proc_column ? width_p : 100) / 100);
 		#ifdef GPU_SUPPORT
 			height = floor(static_cast<double>(Term::height) * (100 - Net::height_p * Net::shown*4 / ((Gpu::shown != 0 and Cpu::shown) + 4)) / 100) - Cpu::height - Gpu::total_height;
 		#else
 			height = floor(static_cast<double>(Term::height) * (100 - Cpu::height_p * Cpu::shown - Net::height_p * Net::shown) / 100);
 		#endif
-			x = (proc_left and Proc::shown) ? Term::width - width + 1: 1;
+			x = (proc_left and proc_column) ? Term::width - width + 1: 1;
 			if (mem_below_net and Net::shown)
 		#ifdef GPU_SUPPORT
 				y = Term::height - height + 1 - (cpu_bottom ? Cpu::height : 0);
@@ -2467,13 +2646,13 @@ namespace Draw {
 		//* Calculate and draw net box outlines
 		if (Net::shown) {
 			using namespace Net;
-			width = round((double)Term::width * (Proc::shown ? width_p : 100) / 100);
+			width = round((double)Term::width * (proc_column ? width_p : 100) / 100);
 		#ifdef GPU_SUPPORT
 			height = Term::height - Cpu::height - Gpu::total_height - Mem::height;
 		#else
 			height = Term::height - Cpu::height - Mem::height;
 		#endif
-			x = (proc_left and Proc::shown) ? Term::width - width + 1 : 1;
+			x = (proc_left and proc_column) ? Term::width - width + 1 : 1;
 			if (mem_below_net and Mem::shown)
 			#ifdef GPU_SUPPORT
 				y = (cpu_bottom ? 1 : Cpu::height + 1) + Gpu::total_height;
@@ -2513,8 +2692,27 @@ namespace Draw {
 		#else
 			y = (cpu_bottom and Cpu::shown) ? 1 : Cpu::height + 1;
 		#endif
+			if (Cgroup::shown) height -= max(Cgroup::min_height, (int)round((double)height * Cgroup::height_p / 100));
 			select_max = height - 3;
 			box = createBox(x, y, width, height, Theme::c("proc_box"), true, "proc", "", 4);
 		}
+
+		//* Calculate and draw cgroup box outlines
+		if (Cgroup::shown) {
+			using namespace Cgroup;
+			width = Term::width - (Mem::shown ? Mem::width : (Net::shown ? Net::width : 0));
+		#ifdef GPU_SUPPORT
+			height = Term::height - Cpu::height - Gpu::total_height - Proc::height;
+		#else
+			height = Term::height - Cpu::height - Proc::height;
+		#endif
+			x = proc_left ? 1 : Term::width - width + 1;
+		#ifdef GPU_SUPPORT
+			y = ((cpu_bottom and Cpu::shown) ? 1 : Cpu::height + 1) + Gpu::total_height + Proc::height;
+		#else
+			y = ((cpu_bottom and Cpu::shown) ? 1 : Cpu::height + 1) + Proc::height;
+		#endif
+			box = createBox(x, y, width, height, Theme::c("proc_box"), true, "cgroup", "", 0);
+		}
 	}
 }
@@ -298,6 +298,8 @@ namespace Input {
 				bool keep_going = false;
 				bool no_update = true;
 				bool redraw = true;
+				//? A group row stands for many processes, signals, renice and follow only apply to single processes
+				const bool group_selected = Proc::group_mode() and Config::getI("proc_selected") > 0;
 				if (filtering) {
 					if (key == "enter" or key == "down") {
 						Config::set("proc_filter", Proc::filter.text);
@@ -323,18 +325,12 @@ namespace Input {
 						return;
 				}
 				else if (key == "left" or (vim_keys and key == "h")) {
-					int cur_i = v_index(Proc::sort_vector, Config::getS("proc_sorting"));
-					if (--cur_i < 0)
-						cur_i = Proc::sort_vector.size() - 1;
-					Config::set("proc_sorting", Proc::sort_vector.at(cur_i));
+					Config::set("proc_sorting", Proc::next_sorting(Config::getS("proc_sorting"), -1));
 					Config::set("update_following", true);
 					if (Config::getB("proc_tree")) no_update = false;
 				}
 				else if (key == "right" or (vim_keys and key == "l")) {
-					int cur_i = v_index(Proc::sort_vector, Config::getS("proc_sorting"));
-					if (std::cmp_greater(++cur_i, Proc::sort_vector.size() - 1))
-						cur_i = 0;
-					Config::set("proc_sorting", Proc::sort_vector.at(cur_i));
+					Config::set("proc_sorting", Proc::next_sorting(Config::getS("proc_sorting"), 1));
 					Config::set("update_following", true);
 					if (Config::getB("proc_tree")) no_update = false;
 				}
@@ -348,6 +344,18 @@ namespace Input {
 					no_update = false;
 					Config::set("update_following", true);
 				}
+				else if (key == "T") {
+					Config::flip("proc_threads");
+					no_update = false;
+					Config::set("update_following", true);
+				}
+			#ifdef __linux__
+				else if (key == "g" and not vim_keys) {
+					Config::flip("proc_group");
+					no_update = false;
+					Config::set("update_following", true);
+				}
+			#endif
 				else if (key == "E" and Config::getB("proc_tree")) {
 					atomic_wait(Runner::active);
 					Proc::collapse_all = 1;
@@ -356,7 +364,7 @@ namespace Input {
 				else if (is_in(key, "u")) {
 					Config::flip("pause_proc_list");
 				}
-				else if (is_in(key, "F")) {
+				else if (is_in(key, "F") and not group_selected) {
 					if (Config::getI("proc_selected") != 0 and Config::getI("followed_pid") != Config::getI("selected_pid")) {
 						Config::set("follow_process", true);
 						Config::set("followed_pid", Config::getI("selected_pid"));
@@ -458,6 +466,15 @@ namespace Input {
 					else
 						keep_going = true;
 				}
+				//? Enter on a program group row shows the processes of that program
+				else if (key == "enter" and group_selected) {
+					Config::set("proc_filter", Proc::group_filter(Proc::selected_name));
+					Config::set("proc_group", false);
+					Config::set("proc_start", 0);
+					Config::set("proc_selected", 0);
+					no_update = false;
+					Config::set("update_following", true);
+				}
 				else if (is_in(key, "enter", "info_enter")) {
 					if (Config::getI("proc_selected") == 0 and not Config::getB("show_detailed")) {
 						return;
@@ -499,19 +516,19 @@ namespace Input {
 						no_update = false;
 					}
 				}
-				else if (is_in(key, "t", kill_key) and (Config::getB("show_detailed") or Config::getI("selected_pid") > 0)) {
+				else if (is_in(key, "t", kill_key) and not group_selected and (Config::getB("show_detailed") or Config::getI("selected_pid") > 0)) {
 					atomic_wait(Runner::active);
 					if (Config::getB("show_detailed") and Config::getI("proc_selected") == 0 and Proc::detailed.status == "Dead") return;
 					Menu::show(Menu::Menus::SignalSend, (key == "t" ? SIGTERM : SIGKILL));
 					return;
 				}
-				else if (key == "s" and (Config::getB("show_detailed") or Config::getI("selected_pid") > 0)) {
+				else if (key == "s" and not group_selected and (Config::getB("show_detailed") or Config::getI("selected_pid") > 0)) {
 					atomic_wait(Runner::active);
 					if (Config::getB("show_detailed") and Config::getI("proc_selected") == 0 and Proc::detailed.status == "Dead") return;
 					Menu::show(Menu::Menus::SignalChoose);
 					return;
 				}
-				else if (key == "N" and (Config::getB("show_detailed") or Config::getI("selected_pid") > 0)) {
+				else if (key == "N" and not group_selected and (Config::getB("show_detailed") or Config::getI("selected_pid") > 0)) {
 					atomic_wait(Runner::active);
 				    if (Config::getB("show_detailed") and Config::getI("proc_selected") == 0 and Proc::detailed.status == "Dead") return;
 				    Menu::show(Menu::Menus::Renice);
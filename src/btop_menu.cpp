@@ -202,15 +202,19 @@ namespace Menu {
 		{"a", "Toggle auto scaling for the network graphs."},
 		{"y", "Toggle synced scaling mode for network graphs."},
 		{"f, /", "To enter a process filter. Start with ! for regex."},
+		{"", "Scope with user: name: cmd: pid: cpu> mem> threads>"},
 		{"F", "Follow selected process."},
 		{"u", "Pause process list."},
 		{"delete", "Clear any entered filter."},
 		{"c", "Toggle per-core cpu usage of processes."},
 		{"r", "Reverse sorting order in processes box."},
 		{"e", "Toggle processes tree view."},
+		{"g", "Toggle grouping processes by program (Linux)."},
+		{"T", "Toggle showing threads in processes box (Linux)."},
 		{"E", "Collapse/expand all processes in tree view."},
 		{"%", "Toggles memory display mode in processes box."},
 		{"Selected +, -", "Expand/collapse the selected process in tree view."},
+		{"Selected enter", "Show processes of the selected group (Linux)."},
 		{"Selected t", "Terminate selected process with SIGTERM - 15."},
 		{"Selected k", "Kill selected process with SIGKILL - 9."},
 		{"Selected s", "Select or enter signal to send to process."},
@@ -297,6 +301,9 @@ namespace Menu {
 				"Manually set which boxes to show.",
 				"",
 				"Available values are \"cpu mem net proc\".",
+			#ifdef __linux__
+				"Or \"cgroup\" for the control group box.",
+			#endif
 			#ifdef GPU_SUPPORT
 				"Or \"gpu0\" through \"gpu5\" for GPU boxes.",
 			#endif
@@ -821,12 +828,18 @@ namespace Menu {
 				"",
 				"Possible values:",
 				"\"pid\", \"program\", \"arguments\", \"threads\",",
-				"\"user\", \"memory\", \"cpu lazy\" and",
-				"\"cpu direct\".",
+				"\"user\", \"memory\", \"cpu lazy\",",
+				"\"cpu direct\", \"io read\", \"io write\",",
+				"\"minor faults\" and \"major faults\".",
 				"",
 				"\"cpu lazy\" updates top process over time.",
 				"\"cpu direct\" updates top process",
-				"directly."},
+				"directly.",
+				"",
+				"\"io read\" and \"io write\" are only",
+				"offered when proc_io is enabled, the",
+				"fault sortings when proc_faults is",
+				"enabled (Linux)."},
 			{"proc_reversed",
 				"Reverse processes sorting order.",
 				"",
@@ -837,6 +850,20 @@ namespace Menu {
 				"Set true to show processes grouped by",
 				"parents with lines drawn between parent",
 				"and child process."},
+			{"proc_group",
+				"(Linux) Group processes by program.",
+				"",
+				"Show one row per program with the number",
+				"of processes and their summed cpu, memory",
+				"and threads.",
+				"",
+				"Enter on a row shows the processes of",
+				"that program. Signals, renice and follow",
+				"only work on single processes.",
+				"",
+				"Not used in tree view or thread mode.",
+				"",
+				"Can also be toggled with \"g\"."},
 			{"proc_aggregate",
 				"Aggregate child's resources in parent.",
 				"",
@@ -895,6 +922,193 @@ namespace Menu {
 				"",
 				"Set to 'True' to filter out internal",
 				"processes started by the Linux kernel."},
+			{"proc_filter_index",
+				"(Linux) Index processes for filtering.",
+				"",
+				"Keep a trigram index of process pids,",
+				"names, commands and users while a filter",
+				"is set and for a minute after it's",
+				"cleared.",
+				"",
+				"Substring filters only check processes",
+				"containing the substring, which is faster",
+				"with many processes or long commands.",
+				"",
+				"Uses memory in proportion to the length",
+				"of all command lines."},
+			{"proc_scope",
+				"(Linux) Only collect processes in a scope.",
+				"",
+				"\"cgroup:<path>\" collects the processes in",
+				"a cgroup and the cgroups below it, with",
+				"the path relative to the cgroup v2 mount.",
+				"",
+				"\"pid:<pid>\" collects a process and all",
+				"its descendants.",
+				"",
+				"Only the scope is read, so collection cost",
+				"scales with the size of the scope.",
+				"",
+				"Empty string to collect all processes.",
+				"Can also be set with --scope."},
+			{"proc_scope_boxes",
+				"(Linux) Cgroup usage in cpu and mem boxes.",
+				"",
+				"With a cgroup scope, show the cpu usage",
+				"of the cgroup as the cpu total and the",
+				"memory of the cgroup in the mem box.",
+				"",
+				"Cpu is relative to the cgroup's cpu.max",
+				"quota and memory to its memory.max limit",
+				"when they are set."},
+			{"proc_events",
+				"(Linux) Track process start and exit.",
+				"",
+				"Use process events from the kernel instead",
+				"of scanning /proc for new and dead pids",
+				"every update, /proc is still scanned",
+				"every 16 updates as a safety net.",
+				"",
+				"Cpu usage of processes that exit between",
+				"updates is added to their parent and the",
+				"number of exited processes is shown.",
+				"",
+				"Requires root or CAP_NET_ADMIN."},
+			{"proc_threads",
+				"(Linux) Show threads in process list.",
+				"",
+				"Show each thread of multithreaded",
+				"processes as its own row with the thread",
+				"id, name, state and cpu usage.",
+				"",
+				"Not used in tree view.",
+				"",
+				"Can also be toggled with \"T\"."},
+			{"proc_fd_budget",
+				"(Linux) Open file budget for process stats.",
+				"",
+				"Percent of the soft open file limit used",
+				"for keeping /proc/[pid]/stat files open",
+				"between updates.",
+				"",
+				"Open files are re-read with one syscall",
+				"instead of open, read and close.",
+				"",
+				"Set to 0 to disable.",
+				"",
+				"Min value: 0",
+				"Max value: 90"},
+			{"proc_io_uring",
+				"(Linux) Read process stats with io_uring.",
+				"",
+				"Batch the open, read and close of",
+				"/proc/[pid]/stat for many processes into",
+				"a single io_uring submission.",
+				"",
+				"Reduces syscalls and context switches on",
+				"systems with many processes.",
+				"",
+				"Requires kernel 5.15 or newer, falls back",
+				"to normal reads if io_uring is blocked."},
+			{"proc_schedstat",
+				"(Linux) Precise process cpu from schedstat.",
+				"",
+				"Calculate process cpu usage from the",
+				"nanosecond run times in",
+				"/proc/[pid]/schedstat instead of ticks.",
+				"",
+				"Accurate at low update intervals and adds",
+				"a Wait% column with the time processes",
+				"spent waiting for a free cpu.",
+				"",
+				"Reads one more file per process."},
+			{"proc_io",
+				"(Linux) Show process io rates.",
+				"",
+				"Adds Rd/s and Wr/s columns with the bytes",
+				"each process read from and wrote to",
+				"storage per second, from /proc/[pid]/io.",
+				"",
+				"Sort with \"io read\" or \"io write\".",
+				"",
+				"Reads one more file per process. Only",
+				"root can read other users' processes."},
+			{"proc_io_interval",
+				"(Linux) Update interval for process io.",
+				"",
+				"Read /proc/[pid]/io only every N updates",
+				"to bound the cost of proc_io. Rates are",
+				"averaged over the time between reads.",
+				"",
+				"Min value: 1",
+				"Max value: 60"},
+			{"proc_faults",
+				"(Linux) Show page fault rate columns.",
+				"",
+				"Adds MinF/s and MajF/s columns with the",
+				"minor and major page faults per second",
+				"of each process.",
+				"",
+				"A burst of major faults is an early sign",
+				"of memory pressure.",
+				"",
+				"Sort with \"minor faults\" or",
+				"\"major faults\"."},
+			{"proc_pss",
+				"(Linux) Show Pss, Uss and Swap columns.",
+				"",
+				"Memory from /proc/[pid]/smaps_rollup.",
+				"Pss divides shared pages between the",
+				"processes sharing them, Uss is memory",
+				"only the process uses.",
+				"",
+				"Read round-robin by a low priority",
+				"background thread, values fill in over",
+				"several updates with many processes."},
+			{"proc_pss_budget",
+				"(Linux) Time budget for Pss sampling.",
+				"",
+				"Milliseconds the background thread spends",
+				"reading smaps_rollup per update.",
+				"",
+				"Min value: 1",
+				"Max value: 1000"},
+			{"proc_cold_interval",
+				"(Linux) Update interval for idle processes.",
+				"",
+				"Processes whose cpu time and memory",
+				"didn't change for 5 updates are only read",
+				"every N updates until they change.",
+				"",
+				"Selected, filtered and exec'd processes",
+				"and a jump in system context switches",
+				"read them right away.",
+				"",
+				"Set to 0 to disable.",
+				"",
+				"Min value: 0",
+				"Max value: 60"},
+			{"proc_workers",
+				"(Linux) Threads used to collect processes.",
+				"",
+				"Number of threads reading process",
+				"information from /proc in parallel.",
+				"",
+				"Can reduce collection time on systems",
+				"with many processes and cpu cores.",
+				"",
+				"Set to 0 to use one thread per core.",
+				"",
+				"Min value: 0",
+				"Max value: 256"},
+			{"cgroup_sorting",
+				"(Linux) Sorting of the cgroup box.",
+				"",
+				"Possible values:",
+				"\"cpu\", \"memory\" and \"io\".",
+				"",
+				"Groups are sorted among their siblings,",
+				"children stay below their parent group."},
 			{"proc_follow_detailed",
 				"Follow selected process with detailed view",
 				"",
@@ -1320,6 +1534,7 @@ static int optionsMenu(const string& key) {
 			{"freq_mode", std::cref(Config::freq_modes)},
 		#endif
 			{"proc_sorting", std::cref(Proc::sort_vector)},
+			{"cgroup_sorting", std::cref(Cgroup::sort_vector)},
 			{"graph_symbol", std::cref(Config::valid_graph_symbols)},
 			{"graph_symbol_cpu", std::cref(Config::valid_graph_symbols_def)},
 			{"graph_symbol_mem", std::cref(Config::valid_graph_symbols_def)},
@@ -1518,6 +1733,9 @@ static int optionsMenu(const string& key) {
 				else if (option == "base_10_sizes") {
 					recollect = true;
 				}
+				else if (is_in(option, "proc_io", "proc_faults") and not Proc::sort_available(Config::getS("proc_sorting"))) {
+					Config::set("proc_sorting", "cpu lazy");
+				}
 				else if (option == "save_config_on_exit" and not Config::getB("save_config_on_exit")) {
 					const bool old_write_new = Config::write_new;
 					Config::write_new = true;
@@ -1544,7 +1762,10 @@ static int optionsMenu(const string& key) {
 					i = v_index(optList, Config::getS(option));
 				}
 
-				if ((key == "right" or (vim_keys and key == "l")) and ++i >= (int)optList.size()) i = 0;
+				//? Sortings of columns that aren't collected are skipped
+				if (option == "proc_sorting")
+					i = v_index(optList, Proc::next_sorting(Config::getS(option), (key == "right" or (vim_keys and key == "l")) ? 1 : -1));
+				else if ((key == "right" or (vim_keys and key == "l")) and ++i >= (int)optList.size()) i = 0;
 				else if ((key == "left" or (vim_keys and key == "h")) and --i < 0) i = optList.size() - 1;
 
 				if (option == "color_theme") {
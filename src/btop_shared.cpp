@@ -17,11 +17,18 @@ tab-size = 4
 */
 
 #include <sys/resource.h>
+#include <algorithm>
+#include <bit>
+#include <charconv>
+#include <cmath>
 #include <filesystem>
 #include <fstream>
+#include <mutex>
 #include <ranges>
 #include <regex>
+#include <span>
 #include <string>
+#include <unordered_map>
 #include <unordered_set>
 
 #include "btop_config.hpp"
@@ -94,6 +101,160 @@ namespace Gpu {
 #endif
 
 namespace Proc {
+	//* Number of processes that exited since last update, -1 if not tracked by the collector
+	atomic<int> exited_procs = -1;
+
+	//* Syscalls used for reading process information and context switches during the last process update, -1 if not tracked by the collector
+	atomic<long long> collect_syscalls = -1, collect_switches = -1;
+
+	//* Processes in the cold tier and percentage of process cpu time shown late because of it, -1 if tiering is disabled or not supported
+	atomic<int> cold_procs = -1;
+	atomic<double> stale_cpu = 0.0;
+
+	const string shared_string::empty_string{};
+
+	namespace {
+		struct string_hash {
+			using is_transparent = void;
+			size_t operator()(std::string_view str) const noexcept { return std::hash<std::string_view>{}(str); }
+		};
+
+		//* Table of strings held by shared_string handles and the number of handles to each string
+		//? Never destroyed, handles in static containers can outlive any other static object
+		//? The lock is only taken to insert or erase entries, copies only touch the atomic count
+		using string_table_t = std::unordered_map<string, std::atomic<size_t>, string_hash, std::equal_to<>>;
+		string_table_t& string_table = *new string_table_t();
+		std::mutex string_table_lock;
+	}
+
+	shared_string::shared_string(const shared_string& other) noexcept : node(other.node) {
+		if (node != nullptr) node->second.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	shared_string& shared_string::operator=(const shared_string& other) noexcept {
+		if (node == other.node) return *this;
+		release();
+		node = other.node;
+		if (node != nullptr) node->second.fetch_add(1, std::memory_order_relaxed);
+		return *this;
+	}
+
+	shared_string& shared_string::operator=(shared_string&& other) noexcept {
+		if (this == &other) return *this;
+		release();
+		node = std::exchange(other.node, nullptr);
+		return *this;
+	}
+
+	void shared_string::assign(std::string_view str) {
+		if (node != nullptr and node->first == str) return;
+		release();
+		if (str.empty()) return;
+		std::lock_guard lock(string_table_lock);
+		auto entry = string_table.find(str);
+		if (entry == string_table.end()) entry = string_table.emplace(str, 0).first;
+		entry->second.fetch_add(1, std::memory_order_relaxed);
+		node = &*entry;
+	}
+
+	void shared_string::release() noexcept {
+		if (node == nullptr) return;
+		//? Dropping a handle that isn't the last one needs no lock
+		auto refs = node->second.load(std::memory_order_relaxed);
+		while (refs > 1) {
+			if (node->second.compare_exchange_weak(refs, refs - 1, std::memory_order_release, std::memory_order_relaxed)) {
+				node = nullptr;
+				return;
+			}
+		}
+		//? Possibly the last handle, new handles to the entry can then only come from assign() which holds the lock
+		std::lock_guard lock(string_table_lock);
+		if (node->second.fetch_sub(1, std::memory_order_acq_rel) == 1) string_table.erase(node->first);
+		node = nullptr;
+	}
+
+	auto shared_string::table_usage() -> std::pair<size_t, size_t> {
+		std::lock_guard lock(string_table_lock);
+		size_t bytes = 0;
+		for (const auto& [str, refs] : string_table) bytes += str.capacity();
+		return {string_table.size(), bytes};
+	}
+
+	history_store history;
+
+	void history_store::record(const vector<proc_info>& procs) {
+		const double cpu_mult = Config::getB("proc_per_core") ? 1.0 : Shared::coreCount;
+		const size_t column = ++tick % samples;
+		for (const auto& p : procs) {
+			auto entry = slots.find(p.pid);
+			if (entry == slots.end()) {
+				if (free_slots.empty()) resize(std::max<size_t>(64, owners.size() + owners.size() / 2));
+				entry = slots.emplace(p.pid, free_slots.back()).first;
+				free_slots.pop_back();
+				owners[entry->second] = {.pid = p.pid, .start = p.cpu_s};
+			}
+			auto& slot = owners[entry->second];
+			//? Pid was reused by a new process
+			if (slot.start != p.cpu_s) slot = {.pid = p.pid, .start = p.cpu_s};
+
+			const size_t index = entry->second * samples + column;
+			cpu_samples[index] = static_cast<uint8_t>(std::clamp(std::round(p.cpu_p * cpu_mult), 0.0, 100.0));
+			mem_samples[index] = static_cast<uint16_t>(std::round(std::log2(static_cast<double>(p.mem) + 1) * 1000));
+			slot.filled = std::min<uint32_t>(slot.filled + 1, samples);
+			slot.seen = tick;
+		}
+
+		//? Release slots of processes not seen this update
+		std::erase_if(slots, [&](const auto& slot) {
+			if (owners[slot.second].seen == tick) return false;
+			free_slots.push_back(slot.second);
+			return true;
+		});
+
+		//? Compact the slab when most slots are unused, so memory follows the number of live processes
+		if (owners.size() > 256 and slots.size() < owners.size() / 4)
+			resize(std::max<size_t>(64, slots.size() * 2));
+	}
+
+	void history_store::resize(size_t new_capacity) {
+		vector<uint8_t> new_cpu(new_capacity * samples);
+		vector<uint16_t> new_mem(new_capacity * samples);
+		vector<owner> new_owners(new_capacity);
+		uint32_t next{};
+		for (auto& [pid, slot] : slots) {
+			std::copy_n(cpu_samples.begin() + slot * samples, samples, new_cpu.begin() + next * samples);
+			std::copy_n(mem_samples.begin() + slot * samples, samples, new_mem.begin() + next * samples);
+			new_owners[next] = owners[slot];
+			slot = next++;
+		}
+		cpu_samples = std::move(new_cpu);
+		mem_samples = std::move(new_mem);
+		owners = std::move(new_owners);
+		free_slots.clear();
+		for (uint32_t i = new_capacity; i-- > next;) free_slots.push_back(i);
+	}
+
+	void history_store::cpu(size_t pid, deque<long long>& out, size_t count) const {
+		const auto entry = slots.find(pid);
+		if (entry == slots.end()) return;
+		const auto& slot = owners[entry->second];
+		for (size_t i = std::min<size_t>(slot.filled, count); i-- > 0;)
+			out.push_back(cpu_samples[entry->second * samples + (slot.seen - i) % samples]);
+	}
+
+	void history_store::mem(size_t pid, deque<long long>& out, size_t count) const {
+		const auto entry = slots.find(pid);
+		if (entry == slots.end()) return;
+		const auto& slot = owners[entry->second];
+		for (size_t i = std::min<size_t>(slot.filled, count); i-- > 0;)
+			out.push_back(std::llround(std::exp2(mem_samples[entry->second * samples + (slot.seen - i) % samples] / 1000.0) - 1));
+	}
+
+	size_t history_store::size(size_t pid) const {
+		const auto entry = slots.find(pid);
+		return entry == slots.end() ? 0 : owners[entry->second].filled;
+	}
+
 bool set_priority(pid_t pid, int priority) {
   if (setpriority(PRIO_PROCESS, pid, priority) == 0) {
     return true;
@@ -101,66 +262,134 @@ bool set_priority(pid_t pid, int priority) {
   return false;
 }
 
-	void proc_sorter(vector<proc_info>& proc_vec, const string& sorting, bool reverse, bool tree) {
-		if (reverse) {
-			switch (v_index(sort_vector, sorting)) {
-			case 0: rng::stable_sort(proc_vec, rng::less{}, &proc_info::pid); 		break;
-			case 1: rng::stable_sort(proc_vec, rng::greater{}, &proc_info::name);		break;
-			case 2: rng::stable_sort(proc_vec, rng::greater{}, &proc_info::cmd); 		break;
-			case 3: rng::stable_sort(proc_vec, rng::less{}, &proc_info::threads);	break;
-			case 4: rng::stable_sort(proc_vec, rng::greater{}, &proc_info::user); 		break;
-			case 5: rng::stable_sort(proc_vec, rng::less{}, &proc_info::mem); 		break;
-			case 6: rng::stable_sort(proc_vec, rng::less{}, &proc_info::cpu_p);		break;
-			case 7: rng::stable_sort(proc_vec, rng::less{}, &proc_info::cpu_c);		break;
-			}
+	//* Sort key for one process, processes are ordered by <key>, then by the full string for string columns and last by <index>
+	//* <key> holds the sorted value, or the first 8 bytes of the sorted string, transformed so that smaller keys always sort first
+	struct sort_key {
+		uint64_t key;
+		uint32_t index;
+	};
+
+	//* Returns the first 8 bytes of <str> as a big-endian integer, which orders the same as comparing the bytes of the strings
+	static uint64_t string_prefix(const string& str) {
+		uint64_t prefix = 0;
+		for (size_t i = 0; i < 8; i++) {
+			prefix = (prefix << 8) | (i < str.size() ? static_cast<unsigned char>(str[i]) : 0);
 		}
-		else {
-			switch (v_index(sort_vector, sorting)) {
-			case 0: rng::stable_sort(proc_vec, rng::greater{}, &proc_info::pid); 		break;
-			case 1: rng::stable_sort(proc_vec, rng::less{}, &proc_info::name);		break;
-			case 2: rng::stable_sort(proc_vec, rng::less{}, &proc_info::cmd); 		break;
-			case 3: rng::stable_sort(proc_vec, rng::greater{}, &proc_info::threads);	break;
-			case 4: rng::stable_sort(proc_vec, rng::less{}, &proc_info::user);		break;
-			case 5: rng::stable_sort(proc_vec, rng::greater{}, &proc_info::mem); 		break;
-			case 6: rng::stable_sort(proc_vec, rng::greater{}, &proc_info::cpu_p);   	break;
-			case 7: rng::stable_sort(proc_vec, rng::greater{}, &proc_info::cpu_c);   	break;
+		return prefix;
+	}
+
+	//* Returns an integer that orders the same as <value>, negative values are treated as 0
+	static uint64_t double_bits(double value) {
+		return value > 0.0 ? std::bit_cast<uint64_t>(value) : 0;
+	}
+
+	void proc_sorter(vector<proc_info>& proc_vec, const string& sorting, bool reverse, bool tree, size_t limit) {
+		static vector<sort_key> keys;
+		static vector<proc_info> sorted;
+		const size_t procs = proc_vec.size();
+		const auto sort_index = v_index(sort_vector, sorting);
+		if (procs < 2 or sort_index >= sort_vector.size()) return;
+		//? The "cpu lazy" threshold is taken from the top rows, so those are always sorted
+		if (limit == 0 or limit > procs) limit = procs;
+		else limit = std::max<size_t>(limit, 8);
+
+		//? Columns where the largest value is shown first unless reversed, string columns are shown in ascending order unless reversed
+		const bool descending = (sort_index == 1 or sort_index == 2 or sort_index == 4) ? reverse : not reverse;
+		shared_string proc_info::* const string_member = (sort_index == 1 ? &proc_info::name : sort_index == 2 ? &proc_info::cmd : sort_index == 4 ? &proc_info::user : nullptr);
+
+		keys.resize(procs);
+		for (uint32_t i = 0; const auto& p : proc_vec) {
+			uint64_t key{};
+			switch (sort_index) {
+			case 0: key = p.pid; 								break;
+			case 1: case 2: case 4: key = string_prefix(p.*string_member);	break;
+			case 3: key = p.threads; 							break;
+			case 5: key = p.mem; 								break;
+			case 6: key = double_bits(p.cpu_p); 				break;
+			case 7: key = double_bits(p.cpu_c); 				break;
+			case 8: key = double_bits(p.io_read_s); 			break;
+			case 9: key = double_bits(p.io_write_s); 			break;
+			case 10: key = double_bits(p.minflt_s); 			break;
+			case 11: key = double_bits(p.majflt_s); 			break;
 			}
+			keys[i] = {descending ? ~key : key, i};
+			i++;
 		}
 
+		auto compare = [&](const sort_key& a, const sort_key& b) {
+			if (a.key != b.key) return a.key < b.key;
+			if (string_member != nullptr) {
+				if (const auto order = (proc_vec[a.index].*string_member).str().compare((proc_vec[b.index].*string_member).str()); order != 0)
+					return descending ? order > 0 : order < 0;
+			}
+			return a.index < b.index;
+		};
+
+		//? Only the first <limit> rows need to be in order when the rest of the list isn't shown
+		if (limit < procs) std::partial_sort(keys.begin(), keys.begin() + limit, keys.end(), compare);
+		else std::sort(keys.begin(), keys.end(), compare);
+
 		//* When sorting with "cpu lazy" push processes over threshold cpu usage to the front regardless of cumulative usage
 		if (not tree and not reverse and sorting == "cpu lazy") {
+			//? Processes outside of the sorted rows can only be moved forward if over the lowest threshold, those are put in order first
+			if (limit < procs) {
+				auto over = std::partition(keys.begin() + limit, keys.end(), [&](const sort_key& k) { return proc_vec[k.index].cpu_p > 10.0; });
+				std::sort(keys.begin() + limit, over, compare);
+			}
 			double max = 10.0, target = 30.0;
-			for (size_t i = 0, x = 0, offset = 0; i < proc_vec.size(); i++) {
-				if (i <= 5 and proc_vec.at(i).cpu_p > max)
-					max = proc_vec.at(i).cpu_p;
+			for (size_t i = 0, x = 0, offset = 0; i < procs; i++) {
+				//? Rows that aren't moved keep their place if all sorted rows were over the threshold, which needs the remaining rows in order
+				if (i == limit and offset == limit and limit < procs) std::sort(keys.begin() + limit, keys.end(), compare);
+				const double cpu_p = proc_vec[keys[i].index].cpu_p;
+				if (i <= 5 and cpu_p > max)
+					max = cpu_p;
 				else if (i == 6)
 					target = (max > 30.0) ? max : 10.0;
-				if (i == offset and proc_vec.at(i).cpu_p > 30.0)
+				if (i == offset and cpu_p > 30.0)
 					offset++;
-				else if (proc_vec.at(i).cpu_p > target) {
-					rotate(proc_vec.begin() + offset, proc_vec.begin() + i, proc_vec.begin() + i + 1);
+				else if (cpu_p > target) {
+					rotate(keys.begin() + offset, keys.begin() + i, keys.begin() + i + 1);
 					if (++x > 10) break;
 				}
 			}
 		}
+
+		//? Move processes into sorted order, each process is moved once
+		sorted.resize(procs);
+		for (size_t i = 0; i < procs; i++) {
+			sorted[i] = std::move(proc_vec[keys[i].index]);
+		}
+		proc_vec.swap(sorted);
 	}
 
 	void tree_sort(vector<tree_proc>& proc_vec, const string& sorting, bool reverse, bool paused, int& c_index, const int index_max, bool collapsed) {
-		if (proc_vec.size() > 1 and not paused) {
-			if (reverse) {
-				switch (v_index(sort_vector, sorting)) {
-				case 3: rng::stable_sort(proc_vec, [](const auto& a, const auto& b) { return a.entry.get().threads < b.entry.get().threads; });	break;
-				case 5: rng::stable_sort(proc_vec, [](const auto& a, const auto& b) { return a.entry.get().mem < b.entry.get().mem; });	break;
-				case 6: rng::stable_sort(proc_vec, [](const auto& a, const auto& b) { return a.entry.get().cpu_p < b.entry.get().cpu_p; });	break;
-				case 7: rng::stable_sort(proc_vec, [](const auto& a, const auto& b) { return a.entry.get().cpu_c < b.entry.get().cpu_c; });	break;
-				}
-			}
+		if (proc_vec.size() > 1) {
+			//? While paused the siblings keep the order they were last shown in
+			if (paused) rng::stable_sort(proc_vec, rng::less{}, [](const tree_proc& t) { return t.entry.get().tree_index; });
 			else {
-				switch (v_index(sort_vector, sorting)) {
-				case 3: rng::stable_sort(proc_vec, [](const auto& a, const auto& b) { return a.entry.get().threads > b.entry.get().threads; });	break;
-				case 5: rng::stable_sort(proc_vec, [](const auto& a, const auto& b) { return a.entry.get().mem > b.entry.get().mem; });	break;
-				case 6: rng::stable_sort(proc_vec, [](const auto& a, const auto& b) { return a.entry.get().cpu_p > b.entry.get().cpu_p; });	break;
-				case 7: rng::stable_sort(proc_vec, [](const auto& a, const auto& b) { return a.entry.get().cpu_c > b.entry.get().cpu_c; });	break;
+				//? Siblings are not in any order before this, ties are ordered by pid so the tree doesn't shuffle between updates
+				const auto sort_index = v_index(sort_vector, sorting);
+				const bool descending = (sort_index == 1 or sort_index == 2 or sort_index == 4) ? reverse : not reverse;
+				auto sort_by = [&](auto key) {
+					rng::sort(proc_vec, [&](const tree_proc& a, const tree_proc& b) {
+						const auto &first = a.entry.get(), &second = b.entry.get();
+						if (const auto x = key(first), y = key(second); x != y) return descending ? y < x : x < y;
+						return first.pid < second.pid;
+					});
+				};
+				switch (sort_index) {
+				case 0: sort_by([](const proc_info& p) { return p.pid; });						break;
+				case 1: sort_by([](const proc_info& p) { return std::string_view{p.name}; });	break;
+				case 2: sort_by([](const proc_info& p) { return std::string_view{p.cmd}; });	break;
+				case 3: sort_by([](const proc_info& p) { return p.threads; });					break;
+				case 4: sort_by([](const proc_info& p) { return std::string_view{p.user}; });	break;
+				case 5: sort_by([](const proc_info& p) { return p.mem; });						break;
+				case 6: sort_by([](const proc_info& p) { return p.cpu_p; });					break;
+				case 7: sort_by([](const proc_info& p) { return p.cpu_c; });					break;
+				case 8: sort_by([](const proc_info& p) { return p.io_read_s; });				break;
+				case 9: sort_by([](const proc_info& p) { return p.io_write_s; });				break;
+				case 10: sort_by([](const proc_info& p) { return p.minflt_s; });				break;
+				case 11: sort_by([](const proc_info& p) { return p.majflt_s; });				break;
 				}
 			}
 		}
@@ -173,28 +402,382 @@ bool set_priority(pid_t pid, int priority) {
 		}
 	}
 
+	proc_filter::proc_filter(const string& filter) : source(filter) {
+		string free_text;
+		bool scoped = false;
+		for (const auto& token : ssplit(filter)) {
+			if (auto t = parse_term(token); t.has_value()) {
+				terms.push_back(std::move(t.value()));
+				scoped = true;
+			}
+			else {
+				if (not free_text.empty()) free_text += ' ';
+				free_text += token;
+			}
+		}
+		//? Without scoped terms the whole filter is used as is, same as before field scoped terms were supported
+		if (not scoped) free_text = filter;
+		if (not free_text.empty()) {
+			if (free_text.starts_with('!')) terms.push_back({field::any, op::regex, free_text.substr(1)});
+			else terms.push_back({field::any, op::contains, free_text});
+		}
+
+		//? Substrings are matched case insensitive against a lowercase copy made once here
+		for (auto& t : terms) {
+			if (t.cmp == op::contains) t.value = str_to_lower(t.value);
+		}
+
+		// An incomplete regex throws, see issue https://github.com/aristocratos/btop/issues/1133
+		try {
+			for (auto& t : terms) {
+				if (t.cmp == op::regex and not t.value.empty()) t.re.emplace(t.value, std::regex::extended);
+			}
+		} catch (std::regex_error& /* unused */) {
+			valid = false;
+		}
+	}
+
+	auto proc_filter::parse_term(std::string_view token) -> std::optional<term> {
+		static const array<std::pair<std::string_view, field>, 4> text_fields = {{
+			{"pid:", field::pid}, {"name:", field::name}, {"cmd:", field::cmd}, {"user:", field::user}
+		}};
+		static const array<std::pair<std::string_view, field>, 3> value_fields = {{
+			{"cpu", field::cpu}, {"mem", field::mem}, {"threads", field::threads}
+		}};
+		static const array<std::pair<std::string_view, op>, 5> operators = {{
+			{">=", op::greater_eq}, {"<=", op::less_eq}, {">", op::greater}, {"<", op::less}, {"=", op::equal}
+		}};
+
+		for (const auto& [prefix, where] : text_fields) {
+			if (not token.starts_with(prefix)) continue;
+			token.remove_prefix(prefix.size());
+			if (token.starts_with('!')) return term{where, op::regex, string{token.substr(1)}};
+			return term{where, op::contains, string{token}};
+		}
+
+		for (const auto& [name, where] : value_fields) {
+			if (not token.starts_with(name)) continue;
+			token.remove_prefix(name.size());
+			auto oper = rng::find_if(operators, [&](const auto& o) { return token.starts_with(o.first); });
+			if (oper == operators.end()) return std::nullopt;
+			token.remove_prefix(oper->first.size());
+
+			double number{};
+			auto [end, ec] = std::from_chars(token.data(), token.data() + token.size(), number);
+			if (ec != std::errc() or number < 0) return std::nullopt;
+			std::string_view unit{end, static_cast<size_t>(token.data() + token.size() - end)};
+
+			//? Memory can be given with a binary unit suffix, "1G", "512M" or "1GiB"
+			if (where == field::mem and not unit.empty()) {
+				static constexpr std::string_view units = "KMGT";
+				const auto exp = units.find(std::toupper(static_cast<unsigned char>(unit.front())));
+				if (exp != std::string_view::npos) {
+					number *= std::pow(1024.0, exp + 1);
+					unit.remove_prefix(1);
+					if (unit == "i" or unit == "iB" or unit == "ib" or unit == "B" or unit == "b") unit = {};
+				}
+				else if (unit == "B" or unit == "b") unit = {};
+			}
+			if (not unit.empty()) return std::nullopt;
+			return term{where, oper->second, {}, number};
+		}
+
+		return std::nullopt;
+	}
+
+	bool proc_filter::contains_ic(std::string_view str, std::string_view lower_find) {
+		if (lower_find.empty()) return not str.empty();
+		const char first_lower = lower_find.front();
+		const char first_upper = std::toupper(static_cast<unsigned char>(first_lower));
+		for (size_t i = 0; i + lower_find.size() <= str.size(); i++) {
+			if (str[i] != first_lower and str[i] != first_upper) continue;
+			size_t j = 1;
+			while (j < lower_find.size() and std::tolower(static_cast<unsigned char>(str[i + j])) == lower_find[j]) j++;
+			if (j == lower_find.size()) return true;
+		}
+		return false;
+	}
+
+	bool proc_filter::matches_term(const term& t, const proc_info& proc) {
+		//? Empty values and empty regexes match everything while a scoped term is being typed
+		if ((t.cmp == op::regex and not t.re.has_value()) or (t.cmp == op::contains and t.value.empty())) return true;
+
+		array<char, 24> pid_buf;
+		const auto pid_end = std::to_chars(pid_buf.data(), pid_buf.data() + pid_buf.size(), proc.pid).ptr;
+		const std::string_view pid{pid_buf.data(), static_cast<size_t>(pid_end - pid_buf.data())};
+
+		auto compare = [&t](double value) {
+			switch (t.cmp) {
+			case op::greater:		return value > t.number;
+			case op::greater_eq:	return value >= t.number;
+			case op::less:			return value < t.number;
+			case op::less_eq:		return value <= t.number;
+			case op::equal:			return value == t.number;
+			default:				return false;
+			}
+		};
+
+		switch (t.where) {
+		case field::any:
+			if (t.cmp == op::regex)
+				return std::regex_search(pid.begin(), pid.end(), *t.re) or std::regex_search(proc.name.str(), *t.re)
+					or std::regex_match(proc.cmd.str(), *t.re) or std::regex_search(proc.user.str(), *t.re);
+			return pid.contains(t.value) or contains_ic(proc.name, t.value)
+				or contains_ic(proc.cmd, t.value) or contains_ic(proc.user, t.value);
+		case field::pid:
+			return (t.cmp == op::regex ? std::regex_search(pid.begin(), pid.end(), *t.re) : pid.contains(t.value));
+		case field::name:
+			return (t.cmp == op::regex ? std::regex_search(proc.name.str(), *t.re) : contains_ic(proc.name, t.value));
+		case field::cmd:
+			return (t.cmp == op::regex ? std::regex_search(proc.cmd.str(), *t.re) : contains_ic(proc.cmd, t.value));
+		case field::user:
+			return (t.cmp == op::regex ? std::regex_search(proc.user.str(), *t.re) : contains_ic(proc.user, t.value));
+		case field::cpu:
+			return compare(proc.cpu_p);
+		case field::mem:
+			return compare(static_cast<double>(proc.mem));
+		case field::threads:
+			return compare(static_cast<double>(proc.threads));
+		}
+		return false;
+	}
+
+	bool proc_filter::operator()(const proc_info& proc) const {
+		return valid and rng::all_of(terms, [&proc](const auto& t) { return matches_term(t, proc); });
+	}
+
+	bool proc_filter::narrows(const proc_filter& other) const {
+		if (not valid) return true;
+		if (not other.valid) return false;
+
+		//? A term implies another term on the same field if it is at least as strict
+		auto implies = [](const term& a, const term& b) {
+			if (a.where != b.where or (a.cmp == op::regex) != (b.cmp == op::regex)) return false;
+			switch (b.cmp) {
+			case op::contains:		return a.cmp == op::contains and a.value.contains(b.value);
+			case op::regex:			return a.value == b.value;
+			case op::greater:		return (a.cmp == op::greater and a.number >= b.number) or ((a.cmp == op::greater_eq or a.cmp == op::equal) and a.number > b.number);
+			case op::greater_eq:	return (a.cmp == op::greater or a.cmp == op::greater_eq or a.cmp == op::equal) and a.number >= b.number;
+			case op::less:			return (a.cmp == op::less and a.number <= b.number) or ((a.cmp == op::less_eq or a.cmp == op::equal) and a.number < b.number);
+			case op::less_eq:		return (a.cmp == op::less or a.cmp == op::less_eq or a.cmp == op::equal) and a.number <= b.number;
+			case op::equal:			return a.cmp == op::equal and a.number == b.number;
+			}
+			return false;
+		};
+
+		return rng::all_of(other.terms, [&](const term& b) {
+			return (b.value.empty() and (b.cmp == op::contains or b.cmp == op::regex))
+				or rng::any_of(terms, [&](const term& a) { return implies(a, b); });
+		});
+	}
+
+	auto compiled_filter(const string& filter, bool& narrowed) -> const proc_filter& {
+		static proc_filter current;
+		narrowed = false;
+		if (filter != current.text()) {
+			proc_filter next{filter};
+			narrowed = next.narrows(current);
+			current = std::move(next);
+		}
+		return current;
+	}
+
 	auto matches_filter(const proc_info& proc, const std::string& filter) -> bool {
-		if (filter.starts_with("!")) {
-			if (filter.size() == 1) {
-				return true;
+		bool narrowed{};
+		return compiled_filter(filter, narrowed)(proc);
+	}
+
+	auto proc_filter::required_substrings() const -> vector<std::string_view> {
+		vector<std::string_view> out;
+		if (not valid) return out;
+		for (const auto& t : terms) {
+			if (t.cmp == op::contains and not t.value.empty() and (t.where == field::any or t.where == field::pid
+				or t.where == field::name or t.where == field::cmd or t.where == field::user))
+				out.emplace_back(t.value);
+		}
+		return out;
+	}
+
+	namespace {
+		//? Trigrams are case folded the same way as the filter folds substrings
+		const auto fold_table = [] {
+			array<uint8_t, 256> table{};
+			for (int c = 0; c < 256; c++) table[c] = static_cast<uint8_t>(::tolower(c));
+			return table;
+		}();
+
+		//* Calls <fn> with every trigram of <str>, each character is folded once
+		template <typename Fn>
+		inline void each_trigram(std::string_view str, Fn&& fn) {
+			uint32_t t = 0;
+			for (size_t i = 0; i < str.size(); i++) {
+				t = (t << 8 | fold_table[static_cast<unsigned char>(str[i])]) & 0xFFFFFF;
+				if (i >= 2) fn(t);
 			}
+		}
+	}
 
-			// An incomplete regex throws, see issue https://github.com/aristocratos/btop/issues/1133
-			try {
-				std::regex regex { filter.substr(1), std::regex::extended };
-				return std::regex_search(std::to_string(proc.pid), regex) || std::regex_search(proc.name, regex) ||
-							 std::regex_match(proc.cmd, regex) || std::regex_search(proc.user, regex);
-			} catch (std::regex_error& /* unused */) {
-				return false;
+	auto trigram_index::entry_of(uint32_t t, bool create) -> table_entry* {
+		//? Fibonacci hashing, the high bits of the product depend on all characters of the trigram
+		auto home = [this](uint32_t key) { return static_cast<size_t>((key * 0x9E3779B1u) >> (32 - std::countr_zero(table.size()))); };
+		//? The table is looked up for every character of every indexed string, so it's kept at most half full
+		if (create and (postings.size() + 1) * 2 > table.size()) {
+			vector<table_entry> old(std::max<size_t>(1024, table.size() * 2));
+			old.swap(table);
+			for (const auto& entry : old) {
+				if (entry.key == 0) continue;
+				for (size_t i = home(entry.key);; i = (i + 1) & (table.size() - 1)) {
+					if (table[i].key == 0) {
+						table[i] = entry;
+						break;
+					}
+				}
 			}
 		}
+		if (table.empty()) return nullptr;
+		const uint32_t key = t + 1;
+		for (size_t i = home(key);; i = (i + 1) & (table.size() - 1)) {
+			if (table[i].key == key) return &table[i];
+			if (table[i].key != 0) continue;
+			if (not create) return nullptr;
+			table[i] = {key, static_cast<uint32_t>(postings.size()), 0};
+			postings.emplace_back();
+			return &table[i];
+		}
+	}
 
-		return std::to_string(proc.pid).contains(filter) || s_contains_ic(proc.name, filter) ||
-					 s_contains_ic(proc.cmd, filter) || s_contains_ic(proc.user, filter);
+	void trigram_index::insert(uint32_t index) {
+		const auto& entry = slots[index];
+		array<char, 24> pid_buf;
+		const auto pid_end = std::to_chars(pid_buf.data(), pid_buf.data() + pid_buf.size(), entry.pid).ptr;
+		for (const std::string_view str : {std::string_view{pid_buf.data(), static_cast<size_t>(pid_end - pid_buf.data())},
+										  std::string_view{entry.name}, std::string_view{entry.cmd}, std::string_view{entry.user}}) {
+			each_trigram(str, [&](uint32_t t) {
+				auto& entry = *entry_of(t, true);
+				if (entry.last == index + 1) return;
+				entry.last = index + 1;
+				postings[entry.list].push_back(index);
+			});
+		}
 	}
 
-	void _tree_gen(proc_info& cur_proc, vector<proc_info>& in_procs, vector<tree_proc>& out_procs,
-		int cur_depth, bool collapsed, const string& filter, bool found, bool no_update, bool should_filter) {
+	void trigram_index::compact() {
+		//? Renumbering keeps the order of the live slots, so posting lists stay sorted
+		vector<uint32_t> renumber(slots.size(), UINT32_MAX);
+		uint32_t next = 0;
+		for (uint32_t i = 0; i < slots.size(); i++) {
+			if (not slots[i].alive) continue;
+			renumber[i] = next;
+			if (next != i) slots[next] = std::move(slots[i]);
+			next++;
+		}
+		slots.resize(next);
+		for (auto& [pid, index] : by_pid) index = renumber[index];
+		//? Emptied lists are kept, the set of trigrams seen stays small compared to the lists
+		for (auto& list : postings) {
+			std::erase_if(list, [&renumber](uint32_t index) { return renumber[index] == UINT32_MAX; });
+			for (auto& index : list) index = renumber[index];
+		}
+		for (auto& entry : table) entry.last = 0;
+		dead = 0;
+	}
+
+	void trigram_index::sync(const vector<proc_info>& rows) {
+		++generation;
+		complete = true;
+		for (uint32_t row = 0; const auto& p : rows) {
+			auto [entry, inserted] = by_pid.try_emplace(p.pid, 0);
+			if (not inserted) {
+				auto& old = slots[entry->second];
+				//? A pid shown twice can't be mapped to a single row
+				if (old.generation == generation) complete = false;
+				if (old.name == p.name and old.cmd == p.cmd and old.user == p.user) {
+					old.row = row++;
+					old.generation = generation;
+					continue;
+				}
+				old = {};
+				dead++;
+			}
+			entry->second = slots.size();
+			slots.push_back({p.pid, p.name, p.cmd, p.user, row++, generation, true});
+			insert(entry->second);
+		}
+
+		//? Rows that weren't seen in this call are gone
+		if (by_pid.size() > rows.size()) {
+			std::erase_if(by_pid, [&](const auto& entry) {
+				auto& old = slots[entry.second];
+				if (old.generation == generation) return false;
+				old = {};
+				dead++;
+				return true;
+			});
+		}
+		if (dead > 1024 and dead > slots.size() / 2) compact();
+	}
+
+	bool trigram_index::candidates(const proc_filter& filter, vector<size_t>& out) {
+		out.clear();
+		if (not complete) return false;
+		vector<const vector<uint32_t>*> lists;
+		bool missing = false;
+		for (const auto value : filter.required_substrings()) {
+			each_trigram(value, [&](uint32_t t) {
+				const auto entry = entry_of(t, false);
+				if (entry == nullptr or postings[entry->list].empty()) missing = true;
+				else lists.push_back(&postings[entry->list]);
+			});
+		}
+		//? A trigram no row contains means no row can match
+		if (missing) return true;
+		if (lists.empty()) return false;
+
+		//? Intersect starting from the shortest list, the longer lists are only searched for the remaining slots
+		rng::sort(lists, rng::less{}, [](const auto* list) { return list->size(); });
+		scratch.clear();
+		for (const auto index : *lists.front()) {
+			if (slots[index].alive and slots[index].generation == generation) scratch.push_back(index);
+		}
+		for (const auto* list : lists | rng::views::drop(1)) {
+			if (scratch.empty()) break;
+			auto pos = list->begin();
+			size_t kept = 0;
+			for (const auto index : scratch) {
+				pos = std::lower_bound(pos, list->end(), index);
+				if (pos == list->end()) break;
+				if (*pos == index) scratch[kept++] = index;
+			}
+			scratch.resize(kept);
+		}
+		out.reserve(scratch.size());
+		for (const auto index : scratch) out.push_back(slots[index].row);
+		return true;
+	}
+
+	bool trigram_index::usable(const proc_filter& filter) {
+		return rng::any_of(filter.required_substrings(), [](const auto value) { return value.size() >= 3; });
+	}
+
+	void trigram_index::clear() {
+		slots.clear();
+		by_pid.clear();
+		postings.clear();
+		table.clear();
+		dead = 0;
+		complete = false;
+	}
+
+	size_t trigram_index::postings_size() const {
+		size_t size = 0;
+		for (const auto& list : postings) size += list.size();
+		return size;
+	}
+
+	//* Shared implementation of _tree_gen(), <children_of> returns a range of the children of a process
+	template<typename ChildrenOf>
+	static void _tree_gen_impl(proc_info& cur_proc, vector<proc_info>& in_procs, vector<tree_proc>& out_procs,
+		int cur_depth, bool collapsed, const string& filter, bool found, bool no_update, bool should_filter, bool aggregate, const ChildrenOf& children_of) {
 		bool filtering = false;
 
 		//? If filtering, include children of matching processes
@@ -231,12 +814,12 @@ bool set_priority(pid_t pid, int priority) {
 		}
 
 		//? Recursive iteration over all children
-		for (auto& p : rng::equal_range(in_procs, cur_proc.pid, rng::less{}, &proc_info::ppid)) {
+		for (proc_info& p : children_of(cur_proc)) {
 			if (collapsed and not filtering) {
 				cur_proc.filtered = true;
 			}
 
-			_tree_gen(p, in_procs, out_procs.back().children, cur_depth + 1, (collapsed or cur_proc.collapsed), filter, found, no_update, should_filter);
+			_tree_gen_impl(p, in_procs, out_procs.back().children, cur_depth + 1, (collapsed or cur_proc.collapsed), filter, found, no_update, should_filter, aggregate, children_of);
 
 			if (not no_update and not filtering and (collapsed or cur_proc.collapsed)) {
 				//auto& parent = cur_proc;
@@ -244,20 +827,99 @@ bool set_priority(pid_t pid, int priority) {
 					cur_proc.cpu_p += p.cpu_p;
 					cur_proc.cpu_c += p.cpu_c;
 					cur_proc.mem += p.mem;
+					cur_proc.io_read_s += p.io_read_s;
+					cur_proc.io_write_s += p.io_write_s;
+					cur_proc.minflt_s += p.minflt_s;
+					cur_proc.majflt_s += p.majflt_s;
+					cur_proc.pss += p.pss;
+					cur_proc.uss += p.uss;
+					cur_proc.swap += p.swap;
+					cur_proc.rollup_sampled |= p.rollup_sampled;
 					cur_proc.threads += p.threads;
 				}
 				filter_found++;
 				p.filtered = true;
 			}
-			else if (Config::getB("proc_aggregate") and p.state != 'X') {
+			else if (aggregate and p.state != 'X') {
 				cur_proc.cpu_p += p.cpu_p;
 				cur_proc.cpu_c += p.cpu_c;
 				cur_proc.mem += p.mem;
+				cur_proc.io_read_s += p.io_read_s;
+				cur_proc.io_write_s += p.io_write_s;
+				cur_proc.minflt_s += p.minflt_s;
+				cur_proc.majflt_s += p.majflt_s;
+				cur_proc.pss += p.pss;
+				cur_proc.uss += p.uss;
+				cur_proc.swap += p.swap;
+				cur_proc.rollup_sampled |= p.rollup_sampled;
 				cur_proc.threads += p.threads;
 			}
 		}
 	}
 
+	void _tree_gen(proc_info& cur_proc, vector<proc_info>& in_procs, vector<tree_proc>& out_procs,
+		int cur_depth, bool collapsed, const string& filter, bool found, bool no_update, bool should_filter) {
+		_tree_gen_impl(cur_proc, in_procs, out_procs, cur_depth, collapsed, filter, found, no_update, should_filter, Config::getB("proc_aggregate"),
+			[&in_procs](const proc_info& parent) { return rng::equal_range(in_procs, parent.pid, rng::less{}, &proc_info::ppid); });
+	}
+
+	void _tree_gen(proc_info& cur_proc, vector<proc_info>& in_procs, const tree_adjacency& adjacency, const std::unordered_map<size_t, size_t>& index,
+		vector<tree_proc>& out_procs, int cur_depth, bool collapsed, const string& filter, bool found, bool no_update, bool should_filter) {
+		static const vector<size_t> no_children;
+		_tree_gen_impl(cur_proc, in_procs, out_procs, cur_depth, collapsed, filter, found, no_update, should_filter, Config::getB("proc_aggregate"),
+			[&in_procs, &adjacency, &index](const proc_info& parent) {
+				const auto children = adjacency.children.find(parent.pid);
+				return std::span{children == adjacency.children.end() ? no_children : children->second}
+					| std::views::filter([&index](size_t child) { return index.contains(child); })
+					| std::views::transform([&in_procs, &index](size_t child) -> proc_info& { return in_procs[index.at(child)]; });
+			});
+	}
+
+	void tree_adjacency::link(size_t pid, size_t ppid) {
+		if (const auto known = parents.find(pid); known != parents.end()) {
+			if (known->second == ppid) return;
+			auto& siblings = children[known->second];
+			if (const auto pos = rng::find(siblings, pid); pos != siblings.end()) {
+				*pos = siblings.back();
+				siblings.pop_back();
+			}
+			if (siblings.empty()) children.erase(known->second);
+			known->second = ppid;
+		}
+		else {
+			parents.emplace(pid, ppid);
+			//? Processes that were listed before their parent stop being roots
+			if (const auto orphans = children.find(pid); orphans != children.end()) {
+				for (const auto child : orphans->second) roots.erase(child);
+			}
+		}
+		children[ppid].push_back(pid);
+		if (ppid != pid and parents.contains(ppid)) roots.erase(pid);
+		else roots.insert(pid);
+	}
+
+	void tree_adjacency::unlink(size_t pid) {
+		const auto known = parents.find(pid);
+		if (known == parents.end()) return;
+		auto& siblings = children[known->second];
+		if (const auto pos = rng::find(siblings, pid); pos != siblings.end()) {
+			*pos = siblings.back();
+			siblings.pop_back();
+		}
+		if (siblings.empty()) children.erase(known->second);
+		parents.erase(known);
+		roots.erase(pid);
+		if (const auto orphans = children.find(pid); orphans != children.end()) {
+			for (const auto child : orphans->second) roots.insert(child);
+		}
+	}
+
+	void tree_adjacency::clear() {
+		children.clear();
+		parents.clear();
+		roots.clear();
+	}
+
 	void _collect_prefixes(tree_proc &t, const bool is_last, const string &header) {
 		const bool is_filtered = t.entry.get().filtered;
 		if (is_filtered) t.entry.get().depth = 0;
@@ -294,20 +956,114 @@ bool set_priority(pid_t pid, int priority) {
 	void _auto_collapse_oversized(std::vector<proc_info>& current_procs, const bool tree_mode_change) {
 		//? Only act when the user just switched into tree view
 		const int threshold = Config::getI("proc_tree_auto_collapse");
-		if (threshold <= 0 or not tree_mode_change) return;
+		if (threshold <= 0 or not tree_mode_change or current_procs.empty()) return;
 		//? Never collapse the root process or its direct children, only deeper busy parents
-		const size_t root_ppid = static_cast<size_t>(current_procs.at(0).ppid);
+		const size_t root_ppid = static_cast<size_t>(rng::min(current_procs, rng::less{}, &proc_info::ppid).ppid);
 		std::unordered_set<size_t> root_pids;
+		std::unordered_map<size_t, int> child_count;
 		for (const auto& p : current_procs) {
 			if (static_cast<size_t>(p.ppid) == root_ppid) root_pids.insert(p.pid);
+			child_count[static_cast<size_t>(p.ppid)]++;
 		}
 		for (auto& p : current_procs) {
 			if (static_cast<size_t>(p.ppid) == root_ppid or root_pids.contains(static_cast<size_t>(p.ppid))) continue;
-			if (rng::count(current_procs, p.pid, &proc_info::ppid) >= threshold) {
+			if (auto count = child_count.find(p.pid); count != child_count.end() and count->second >= threshold) {
 				p.collapsed = true;
 			}
 		}
 	}
+
+	void group_programs(const vector<proc_info>& procs, vector<proc_info>& groups) {
+		static std::unordered_map<shared_string, size_t, shared_string::hash> index;
+		index.clear();
+		groups.clear();
+		for (const auto& p : procs) {
+			auto [entry, inserted] = index.try_emplace(p.name, groups.size());
+			if (inserted) {
+				auto& group = groups.emplace_back(p);
+				group.group_size = 1;
+				group.filtered = false;
+				continue;
+			}
+			auto& group = groups[entry->second];
+			group.group_size++;
+			group.threads += p.threads;
+			group.mem += p.mem;
+			group.cpu_p += p.cpu_p;
+			group.cpu_c += p.cpu_c;
+			group.cpu_t += p.cpu_t;
+			group.wait_p += p.wait_p;
+			group.io_read_s += p.io_read_s;
+			group.io_write_s += p.io_write_s;
+			group.minflt_s += p.minflt_s;
+			group.majflt_s += p.majflt_s;
+			group.pss += p.pss;
+			group.uss += p.uss;
+			group.swap += p.swap;
+			group.rollup_sampled |= p.rollup_sampled;
+			if (p.pid < group.pid) {
+				group.pid = p.pid;
+				group.ppid = p.ppid;
+				group.cmd = p.cmd;
+				group.short_cmd = p.short_cmd;
+				group.user = p.user;
+				group.state = p.state;
+				group.p_nice = p.p_nice;
+				group.cpu_s = p.cpu_s;
+				group.unreadable = p.unreadable;
+			}
+		}
+	}
+
+	auto group_filter(std::string_view name) -> string {
+		//? Filters are split on spaces, so spaces in the name are matched with a character class
+		string filter = "name:!^";
+		for (const char c : name) {
+			if (c == ' ') {
+				filter += "[[:space:]]";
+				continue;
+			}
+			if (std::string_view{".[]{}()\\*+?^$|"}.contains(c)) filter += '\\';
+			filter += c;
+		}
+		return filter + '$';
+	}
+
+	bool sort_available(const string& sorting) {
+		if (is_in(sorting, "io read", "io write")) {
+		#ifdef __linux__
+			return Config::getB("proc_io");
+		#else
+			return false;
+		#endif
+		}
+		if (is_in(sorting, "minor faults", "major faults")) {
+		#ifdef __linux__
+			return Config::getB("proc_faults");
+		#else
+			return false;
+		#endif
+		}
+		return v_contains(sort_vector, sorting);
+	}
+
+	auto next_sorting(const string& sorting, int step) -> string {
+		const int count = sort_vector.size();
+		int index = v_index(sort_vector, sorting);
+		for (int n = 0; n < count; n++) {
+			index = ((index + step) % count + count) % count;
+			if (sort_available(sort_vector[index])) return sort_vector[index];
+		}
+		return sorting;
+	}
+
+	bool group_mode() {
+	#ifdef __linux__
+		return Config::getB("proc_group") and not Config::getB("proc_tree") and not Config::getB("proc_threads");
+	#else
+		return false;
+	#endif
+	}
 }
 
 auto detect_container() -> std::optional<std::string> {
@@ -24,10 +24,13 @@ tab-size = 4
 #include <deque>
 #include <filesystem>
 #include <optional>
+#include <regex>
 #include <string>
 #include <string_view>
 #include <tuple>
 #include <unordered_map>
+#include <unordered_set>
+#include <utility>
 #include <vector>
 
 #include <unistd.h>
@@ -296,6 +299,7 @@ namespace Mem {
 			{"swap_total", {}}, {"swap_used", {}}, {"swap_free", {}}};
 		std::unordered_map<string, disk_info> disks;
 		vector<string> disks_order;
+		uint64_t scope_total{};		//? Memory limit of the scoped cgroup when stats are those of the cgroup, 0 otherwise (Linux)
 	};
 
 	//?* Get total system memory
@@ -361,6 +365,10 @@ namespace Net {
 
 namespace Proc {
 	extern atomic<int> numpids;
+	extern atomic<int> exited_procs;
+	extern atomic<long long> collect_syscalls, collect_switches;
+	extern atomic<int> cold_procs;
+	extern atomic<double> stale_cpu;
 
 	extern string box;
 	extern int x, y, width, height, min_width, min_height;
@@ -382,8 +390,18 @@ namespace Proc {
 		"memory",
 		"cpu direct",
 		"cpu lazy",
+		"io read",
+		"io write",
+		"minor faults",
+		"major faults",
 	};
 
+	//* Returns true if processes can be sorted by <sorting> with the current options, the io and fault columns are only collected on Linux
+	bool sort_available(const string& sorting);
+
+	//* Returns the sorting <step> places after <sorting> in sort_vector, skipping sortings that aren't available
+	auto next_sorting(const string& sorting, int step) -> string;
+
 	//? Translation from process state char to explanative string
 	const std::unordered_map<char, string> proc_states = {
 		{'R', "Running"},
@@ -399,15 +417,61 @@ namespace Proc {
 		{'P', "Parked"}
 	};
 
+	//* Handle to an immutable string stored once in a shared table, the stored string is released together with its last handle
+	//* Used for process strings that repeat across many processes, like user names, program names and command lines
+	class shared_string {
+	public:
+		shared_string() = default;
+		explicit shared_string(std::string_view str) { assign(str); }
+		shared_string(const shared_string& other) noexcept;
+		shared_string(shared_string&& other) noexcept : node(std::exchange(other.node, nullptr)) {}
+		~shared_string() { release(); }
+
+		shared_string& operator=(const shared_string& other) noexcept;
+		shared_string& operator=(shared_string&& other) noexcept;
+		shared_string& operator=(std::string_view str) { assign(str); return *this; }
+
+		const string& str() const noexcept { return node != nullptr ? node->first : empty_string; }
+		operator const string&() const noexcept { return str(); }
+		operator std::string_view() const noexcept { return str(); }
+
+		size_t size() const noexcept { return str().size(); }
+		bool empty() const noexcept { return node == nullptr; }
+		const char* c_str() const noexcept { return str().c_str(); }
+		auto begin() const noexcept { return str().begin(); }
+		auto end() const noexcept { return str().end(); }
+		string substr(size_t pos = 0, size_t count = string::npos) const { return str().substr(pos, count); }
+
+		//? Equal strings always share the same table entry
+		friend bool operator==(const shared_string& a, const shared_string& b) noexcept { return a.node == b.node; }
+		friend bool operator==(const shared_string& a, std::string_view b) noexcept { return a.str() == b; }
+		friend auto operator<=>(const shared_string& a, const shared_string& b) noexcept { return a.str() <=> b.str(); }
+
+		//* Hashes the table entry instead of the characters, equal strings share the entry
+		struct hash {
+			size_t operator()(const shared_string& s) const noexcept { return std::hash<const void*>{}(s.node); }
+		};
+
+		//* Returns the number of distinct strings and the number of bytes they hold
+		static auto table_usage() -> std::pair<size_t, size_t>;
+
+	private:
+		using table_entry = std::pair<const string, std::atomic<size_t>>;
+		table_entry* node{};
+		static const string empty_string;
+
+		void assign(std::string_view str);
+		void release() noexcept;
+	};
+
 	//* Container for process information
 	struct proc_info {
 		size_t pid{};
-		string name{};          // defaults to ""
-		string cmd{};           // defaults to ""
-		string short_cmd{};     // defaults to ""
+		shared_string name{};   // defaults to ""
+		shared_string cmd{};    // defaults to ""
+		shared_string short_cmd{}; // defaults to ""
 		size_t threads{};
-		int name_offset{};
-		string user{};          // defaults to ""
+		shared_string user{};   // defaults to ""
 		uint64_t mem{};
 		double cpu_p{};         // defaults to = 0.0
 		double cpu_c{};         // defaults to = 0.0
@@ -416,12 +480,33 @@ namespace Proc {
 		uint64_t ppid{};
 		uint64_t cpu_s{};
 		uint64_t cpu_t{};
+		uint64_t cpu_ct{};      // cpu time of waited for children (Linux)
+		uint64_t run_ns{};      // nanoseconds on cpu from schedstat (Linux)
+		uint64_t wait_ns{};     // nanoseconds waiting on a run queue from schedstat (Linux)
+		double wait_p{};        // percent of time spent waiting on a run queue since last update (Linux)
+		uint64_t io_read{};     // bytes read from storage from /proc/[pid]/io (Linux)
+		uint64_t io_write{};    // bytes written to storage from /proc/[pid]/io (Linux)
+		uint64_t io_time{};     // monotonic time in microseconds when io_read and io_write were read (Linux)
+		double io_read_rate{};  // bytes read per second between the last two io reads (Linux)
+		double io_write_rate{}; // bytes written per second between the last two io reads (Linux)
+		double io_read_s{};     // io_read_rate shown, includes children of collapsed tree rows
+		double io_write_s{};    // io_write_rate shown, includes children of collapsed tree rows
+		uint64_t minflt{};      // minor page faults since process start (Linux)
+		uint64_t majflt{};      // major page faults since process start (Linux)
+		double minflt_s{};      // minor page faults per second since last update (Linux)
+		double majflt_s{};      // major page faults per second since last update (Linux)
+		uint64_t pss{};         // proportional set size in bytes from smaps_rollup, 0 until sampled (Linux)
+		uint64_t uss{};         // private memory in bytes from smaps_rollup, 0 until sampled (Linux)
+		uint64_t swap{};        // swapped out memory in bytes from smaps_rollup, 0 until sampled (Linux)
 		uint64_t death_time{};
 		string prefix{};        // defaults to ""
 		size_t depth{};
 		size_t tree_index{};
 		bool collapsed{};
 		bool filtered{};
+		bool unreadable{};      // reads of cmdline or smaps timed out (Linux)
+		bool rollup_sampled{};  // pss, uss and swap were read from smaps_rollup (Linux)
+		size_t group_size{};    // processes summed into a program group row, 0 for process rows
 	};
 
 	//* Container for process info box
@@ -433,11 +518,52 @@ namespace Proc {
 		long long first_mem = -1;
 		deque<long long> cpu_percent;
 		deque<long long> mem_bytes;
+		vector<proc_info> top_threads;	//? Busiest threads of the process by cpu usage, only collected on Linux
 	};
 
 	//? Contains all info for proc detailed box
 	extern detail_container detailed;
 
+	//* Fixed size cpu and memory history of every live process, kept in one slab with a slot per pid
+	//* Cpu is stored as percent of one core in a byte and memory as a log2 scaled 16 bit value,
+	//* so the store never uses more than capacity() * samples * 3 bytes
+	class history_store {
+	public:
+		static constexpr size_t samples = 64;
+
+		//* Append current cpu and memory usage of <procs>, slots of processes no longer present are released
+		void record(const vector<proc_info>& procs);
+
+		//* Append up to <count> recorded samples of <pid> to <out>, oldest first
+		void cpu(size_t pid, deque<long long>& out, size_t count = samples) const;
+		void mem(size_t pid, deque<long long>& out, size_t count = samples) const;
+
+		//* Number of samples recorded for <pid>
+		size_t size(size_t pid) const;
+
+		size_t used() const { return slots.size(); }
+		size_t capacity() const { return owners.size(); }
+		size_t bytes() const { return cpu_samples.capacity() + mem_samples.capacity() * sizeof(uint16_t); }
+
+	private:
+		struct owner {
+			size_t pid{};
+			uint64_t start{};
+			uint32_t filled{};
+			uint64_t seen{};
+		};
+		vector<uint8_t> cpu_samples;
+		vector<uint16_t> mem_samples;
+		vector<owner> owners;
+		vector<uint32_t> free_slots;
+		std::unordered_map<size_t, uint32_t> slots;
+		uint64_t tick{};
+
+		void resize(size_t new_capacity);
+	};
+
+	extern history_store history;
+
 	//* Collect and sort process information from /proc
 	auto collect(bool no_update = false) -> vector<proc_info>&;
 
@@ -452,23 +578,138 @@ namespace Proc {
 		vector<tree_proc> children;
 	};
 
+	//* Parent to children links between pids, kept between updates and patched for processes that started, exited or got a new parent
+	//* Children are kept in no particular order, siblings are put in order by tree_sort() when the tree is generated
+	struct tree_adjacency {
+		std::unordered_map<size_t, vector<size_t>> children;	//? Child pids by parent pid, also for parents that aren't known
+		std::unordered_map<size_t, size_t> parents;				//? Parent pid of every known pid
+		std::unordered_set<size_t> roots;						//? Known pids whose parent isn't known
+
+		//* Add <pid> with parent <ppid>, or move it to <ppid> if it is known with another parent
+		void link(size_t pid, size_t ppid);
+
+		//* Remove <pid>, its children become roots until they get a new parent
+		void unlink(size_t pid);
+
+		void clear();
+	};
+
 	//* Change priority (nice) of pid, returns true on success otherwise false
 	bool set_priority(pid_t pid, int priority);
 
-	//* Sort vector of proc_info's
-	void proc_sorter(vector<proc_info>& proc_vec, const string& sorting, bool reverse, bool tree = false);
+	//* Sort vector of proc_info's, if <limit> is set only the first <limit> processes are guaranteed to be in sorted order
+	void proc_sorter(vector<proc_info>& proc_vec, const string& sorting, bool reverse, bool tree = false, size_t limit = 0);
 
 	//* Recursive sort of process tree
 	void tree_sort(vector<tree_proc>& proc_vec, const string& sorting, bool reverse, bool paused,
 					int& c_index, const int index_max, bool collapsed = false);
 
+	//* Process filter compiled once from the proc_filter string
+	//* Terms scoped to a field ("pid:", "name:", "cmd:", "user:") match a case insensitive substring of that field,
+	//* or a regex if the value starts with '!'. Comparisons ("cpu>5", "mem>=1G", "threads<4") match on process values.
+	//* Remaining text is matched against pid, name, command and user, as a regex if it starts with '!'. All terms have to match.
+	class proc_filter {
+	public:
+		proc_filter() = default;
+		explicit proc_filter(const string& filter);
+
+		//* Returns true if <proc> matches all terms of the filter
+		bool operator()(const proc_info& proc) const;
+
+		//* Returns true if every process matching this filter is also known to match <other>
+		bool narrows(const proc_filter& other) const;
+
+		const string& text() const { return source; }
+
+		//* Lowercase substrings that the pid, name, command or user of every matching process contains
+		auto required_substrings() const -> vector<std::string_view>;
+
+	private:
+		enum class field { any, pid, name, cmd, user, cpu, mem, threads };
+		enum class op { contains, regex, greater, greater_eq, less, less_eq, equal };
+
+		struct term {
+			field where{};
+			op cmp{};
+			string value{};
+			double number{};
+			std::optional<std::regex> re{};
+		};
+
+		static auto parse_term(std::string_view token) -> std::optional<term>;
+		static bool contains_ic(std::string_view str, std::string_view lower_find);
+		static bool matches_term(const term& t, const proc_info& proc);
+
+		string source;
+		vector<term> terms;
+		bool valid = true;	//? False if a regex failed to compile, nothing matches an incomplete regex
+	};
+
+	//* Returns the compiled filter for <filter>, the filter is only compiled again when <filter> changes
+	//* <narrowed> is set to true if <filter> changed and the new filter narrows down the previous one
+	auto compiled_filter(const string& filter, bool& narrowed) -> const proc_filter&;
+
 	auto matches_filter(const proc_info& proc, const std::string& filter) -> bool;
 
-	//* Generate process tree list
+	//* Trigram index over the pid, name, command and user of process rows, used to find the rows a substring filter can match
+	//* Rows are only indexed again when one of their strings changed, removed rows are dropped from the posting lists in batches
+	class trigram_index {
+	public:
+		//* Update the index to the rows in <rows>, rows with the same pid and strings as in the last call are not read again
+		void sync(const vector<proc_info>& rows);
+
+		//* Replace <out> with the indexes of the rows from the last sync() containing every substring required by <filter>
+		//* Returns false if none of the substrings are long enough to look up, all rows have to be checked then
+		bool candidates(const proc_filter& filter, vector<size_t>& out);
+
+		//* Returns true if <filter> requires a substring long enough to be looked up
+		static bool usable(const proc_filter& filter);
+
+		void clear();
+		bool empty() const { return slots.empty(); }
+
+		//* Returns the number of entries in all posting lists
+		size_t postings_size() const;
+
+	private:
+		struct slot {
+			size_t pid{};
+			shared_string name{}, cmd{}, user{};
+			uint32_t row{};
+			uint32_t generation{};
+			bool alive{};
+		};
+		vector<slot> slots;								//? Appended in order, so every posting list is sorted
+		std::unordered_map<size_t, uint32_t> by_pid;
+		struct table_entry {
+			uint32_t key{};		//? Trigram + 1, 0 for free entries
+			uint32_t list{};
+			uint32_t last{};	//? Slot + 1 of the last entry in the list, lets repeated trigrams of a row skip the list
+		};
+		vector<vector<uint32_t>> postings;				//? Slots containing a trigram
+		vector<table_entry> table;						//? Open addressed, from trigram to posting list
+		vector<uint32_t> scratch;
+		size_t dead{};
+		uint32_t generation{};
+		bool complete{};
+
+		//? Returns the table entry of trigram <t>, or nullptr if <t> has none and <create> is false
+		auto entry_of(uint32_t t, bool create) -> table_entry*;
+		void insert(uint32_t index);
+		void compact();
+	};
+
+	//* Generate process tree list, <in_procs> needs to be sorted by ppid
 	void _tree_gen(proc_info& cur_proc, vector<proc_info>& in_procs, vector<tree_proc>& out_procs,
 				   int cur_depth, bool collapsed, const string& filter,
 				   bool found = false, bool no_update = false, bool should_filter = false);
 
+	//* Generate process tree list using <adjacency> to find children instead of searching <in_procs>, <index> maps pids to positions in <in_procs>
+	void _tree_gen(proc_info& cur_proc, vector<proc_info>& in_procs, const tree_adjacency& adjacency, const std::unordered_map<size_t, size_t>& index,
+				   vector<tree_proc>& out_procs,
+				   int cur_depth, bool collapsed, const string& filter,
+				   bool found = false, bool no_update = false, bool should_filter = false);
+
 	//* Build prefixes for tree view
 	void _collect_prefixes(tree_proc& t, bool is_last, const string &header = "");
 
@@ -477,6 +718,45 @@ namespace Proc {
 
 	//* Auto-collapse processes with many direct children when entering tree mode
 	void _auto_collapse_oversized(std::vector<proc_info>& current_procs, const bool tree_mode_change);
+
+	//* Replace <groups> with one row per program name in <procs>, with the summed cpu, memory and threads of its processes
+	//* Each row keeps the pid, command and user of the program's lowest pid
+	void group_programs(const vector<proc_info>& procs, vector<proc_info>& groups);
+
+	//* Filter matching exactly the processes of program <name>, used for drilling down into a group row
+	auto group_filter(std::string_view name) -> string;
+
+	//* True if the process list shows program group rows, only the Linux collector builds them
+	bool group_mode();
+}
+
+namespace Cgroup {
+	extern string box;
+	extern int x, y, width, height, min_width, min_height;
+	extern bool shown, redraw;
+
+	const vector<string> sort_vector = {"cpu", "memory", "io"};
+
+	struct cgroup_info {
+		string name{};
+		size_t depth{};
+		double cpu_p{};
+		uint64_t mem{}, anon{}, file{};
+		uint64_t io_read{}, io_write{};		//? Bytes per second
+		bool has_mem{}, has_io{};
+	};
+
+	struct cgroup_stats {
+		vector<cgroup_info> groups;			//? Depth first order with siblings sorted by usage, root excluded
+		string root{};
+		bool available{};
+	};
+
+	//* (Linux) Collect cpu, memory and io usage of all groups in the cgroup v2 hierarchy
+	auto collect(bool no_update = false) -> cgroup_stats&;
+
+	//* Draw contents of cgroup box using <stats> as source
+	string draw(const cgroup_stats& stats, bool force_redraw = false, bool data_same = false);
 }
 
 /// Detect container engine.
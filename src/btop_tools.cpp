@@ -121,6 +121,7 @@ namespace Term {
         bool mem = boxes.find("mem") != string::npos;
         bool net = boxes.find("net") != string::npos;
         bool proc = boxes.find("proc") != string::npos;
+        bool cgroup = boxes.find("cgroup") != string::npos;
 	#ifdef GPU_SUPPORT
 		int gpu = 0;
         if (Gpu::count > 0)
@@ -130,14 +131,14 @@ namespace Term {
         int width = 0;
 		if (mem) width = Mem::min_width;
 		else if (net) width = Mem::min_width;
-		width += (proc ? Proc::min_width : 0);
+		width += (proc or cgroup ? max(proc ? Proc::min_width : 0, cgroup ? Cgroup::min_width : 0) : 0);
 		if (cpu and width < Cpu::min_width) width = Cpu::min_width;
 	#ifdef GPU_SUPPORT
 		if (gpu != 0 and width < Gpu::min_width) width = Gpu::min_width;
 	#endif
 
 		int height = (cpu ? Cpu::min_height : 0);
-		if (proc) height += Proc::min_height;
+		if (proc or cgroup) height += (proc ? Proc::min_height : 0) + (cgroup ? Cgroup::min_height : 0);
 		else height += (mem ? Mem::min_height : 0) + (net ? Net::min_height : 0);
 	#ifdef GPU_SUPPORT
 		for (int i = 0; i < gpu; i++)
@@ -1030,6 +1030,9 @@ namespace Proc {
 			detailed = {};
 			detailed.last_pid = pid;
 			detailed.skip_smaps = not Config::getB("proc_info_smaps");
+			//? Start the graphs from the recorded history of the process
+			history.cpu(pid, detailed.cpu_percent);
+			history.mem(pid, detailed.mem_bytes);
 		}
 
 		//? Copy proc_info for process from proc vector
@@ -1160,18 +1163,20 @@ namespace Proc {
 						continue;
 					}
 					new_proc.name = kproc->ki_comm;
+					string cmd;
 					char** argv = kvm_getargv(kd.get(), kproc, 0);
 					if (argv) {
-						for (int i = 0; argv[i] and cmp_less(new_proc.cmd.size(), 1000); i++) {
-							new_proc.cmd += argv[i] + " "s;
+						for (int i = 0; argv[i] and cmp_less(cmd.size(), 1000); i++) {
+							cmd += argv[i] + " "s;
 						}
-						if (not new_proc.cmd.empty()) new_proc.cmd.pop_back();
+						if (not cmd.empty()) cmd.pop_back();
 					}
-					if (new_proc.cmd.empty()) new_proc.cmd = new_proc.name;
-					if (new_proc.cmd.size() > 1000) {
-						new_proc.cmd.resize(1000);
-						new_proc.cmd.shrink_to_fit();
+					if (cmd.empty()) cmd = new_proc.name.str();
+					if (cmd.size() > 1000) {
+						cmd.resize(1000);
+						cmd.shrink_to_fit();
 					}
+					new_proc.cmd = cmd;
 					new_proc.ppid = kproc->ki_ppid;
 					new_proc.cpu_s = round(kproc->ki_start.tv_sec);
 					struct passwd *pwd = getpwuid(kproc->ki_uid);
@@ -1237,6 +1242,9 @@ namespace Proc {
 				redraw = true;
 			}
 
+			//? Record cpu and memory history of all processes
+			history.record(current_procs);
+
 			old_cputimes = cputimes;
 
 		}
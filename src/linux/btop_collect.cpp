@@ -19,27 +19,50 @@ tab-size = 4
 #include <algorithm>
 #include <charconv>
 #include <cmath>
+#include <condition_variable>
 #include <cstdlib>
+#include <cstring>
 #include <filesystem>
 #include <fstream>
+#include <functional>
 #include <future>
 #include <iterator>
+#include <memory>
+#include <mutex>
 #include <numeric>
 #include <optional>
 #include <ranges>
+#include <span>
 #include <string_view>
+#include <thread>
+#include <type_traits>
 #include <unordered_map>
 #include <unordered_set>
 #include <utility>
 
 #include <arpa/inet.h> // for inet_ntop()
+#include <dirent.h>
 #include <dlfcn.h>
 #include <ifaddrs.h>
 #include <net/if.h>
+#include <fcntl.h>
+#include <linux/cn_proc.h>
+#include <linux/connector.h>
+#include <linux/netlink.h>
 #include <netdb.h>
+#include <poll.h>
+#include <sys/inotify.h>
+#include <sys/mman.h>
+#include <sys/resource.h>
+#include <sys/socket.h>
 #include <sys/statvfs.h>
+#include <sys/syscall.h>
 #include <unistd.h>
 
+#if __has_include(<linux/io_uring.h>)
+	#include <linux/io_uring.h>
+#endif
+
 #include <fmt/format.h>
 #include <fmt/std.h>
 
@@ -137,6 +160,189 @@ struct join_thread
 
 };
 
+//* Directory reader using getdents64 directly, fs::directory_iterator allocates a path and a directory_entry for every entry
+//* which adds up when listing /proc every update. Names are string_views into the buffer and only valid during the callback,
+//* a scanner must not be reused from inside its own callback, use a second scanner for nested directories
+class dir_scanner {
+	//? Fixed part of the records returned by getdents64, not exported by all libcs, the null terminated name follows d_type
+	struct linux_dirent64 {
+		uint64_t d_ino;
+		int64_t d_off;
+		unsigned short d_reclen;
+		unsigned char d_type;
+	};
+	static constexpr size_t name_offset = offsetof(linux_dirent64, d_type) + 1;
+
+	std::unique_ptr<std::byte[]> buf;
+	size_t buf_size;
+
+public:
+	explicit dir_scanner(size_t size = 32 << 10) : buf_size(size) {}
+
+	//* Calls <fn>(name, d_type) for every entry of <dir_fd> except "." and "..", if <fn> returns bool the scan stops at the first false
+	//* Returns false if the directory couldn't be read, entries already passed to <fn> are not rolled back
+	template<typename Fn>
+	bool each(int dir_fd, Fn&& fn) {
+		if (not buf) buf = std::make_unique_for_overwrite<std::byte[]>(buf_size);
+		for (;;) {
+			const long bytes = syscall(SYS_getdents64, dir_fd, buf.get(), buf_size);
+			if (bytes <= 0) return bytes == 0;
+			for (long pos = 0; pos < bytes;) {
+				const auto* entry = reinterpret_cast<const linux_dirent64*>(buf.get() + pos);
+				pos += entry->d_reclen;
+				const std::string_view name{reinterpret_cast<const char*>(entry) + name_offset};
+				if (name == "." or name == "..") continue;
+				if constexpr (std::is_same_v<std::invoke_result_t<Fn&, std::string_view, unsigned char>, bool>) {
+					if (not fn(name, entry->d_type)) return true;
+				}
+				else fn(name, entry->d_type);
+			}
+		}
+	}
+
+	template<typename Fn>
+	bool each(const char* path, Fn&& fn) {
+		const int dir_fd = open(path, O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+		if (dir_fd < 0) return false;
+		bool ok;
+		try {
+			ok = each(dir_fd, std::forward<Fn>(fn));
+		}
+		catch (...) {
+			close(dir_fd);
+			throw;
+		}
+		close(dir_fd);
+		return ok;
+	}
+
+	//* Appends every entry of <dir_fd> that is a plain decimal number to <out>, used for pid and tid directories
+	bool numeric(int dir_fd, vector<size_t>& out) {
+		return each(dir_fd, [&out](std::string_view name, unsigned char) {
+			size_t value{};
+			for (const char c : name) {
+				if (c < '0' or c > '9') return;
+				value = value * 10 + (c - '0');
+			}
+			out.push_back(value);
+		});
+	}
+};
+
+//* Reads all of <name> in <dir_fd> into <out>, returns false with errno set if it can't be opened
+bool read_at(int dir_fd, const char* name, string& out) {
+	out.clear();
+	const int fd = openat(dir_fd, name, O_RDONLY | O_CLOEXEC);
+	if (fd < 0) return false;
+	array<char, 4096> buf;
+	for (ssize_t bytes; (bytes = read(fd, buf.data(), buf.size())) > 0;) out.append(buf.data(), bytes);
+	close(fd);
+	return true;
+}
+
+//* Appends the whitespace separated numbers in <text> to <out>
+void parse_numbers(std::string_view text, vector<size_t>& out) {
+	for (auto pos = text.find_first_of("0123456789"); pos != std::string_view::npos; pos = text.find_first_of("0123456789", pos)) {
+		size_t value{};
+		const auto [end, ec] = std::from_chars(text.data() + pos, text.data() + text.size(), value);
+		if (ec == std::errc()) out.push_back(value);
+		pos = end - text.data();
+	}
+}
+
+//* Mount point of the cgroup v2 hierarchy, empty if there is none
+const string& cgroup2_root() {
+	static const string root = [] {
+		ifstream mounts("/proc/self/mounts");
+		string device, mount_point, fs_type, line;
+		while (mounts >> device >> mount_point >> fs_type) {
+			if (fs_type == "cgroup2") return mount_point;
+			getline(mounts, line);
+		}
+		return string{};
+	}();
+	return root;
+}
+
+//* Part of the system that processes are collected from, set with the proc_scope option or the --scope argument
+struct collect_scope {
+	string cgroup;		//? Directory of the scoped cgroup and the cgroups below it, empty if not scoped to a cgroup
+	size_t pid{};		//? Root of the scoped process subtree, 0 if not scoped to a pid
+
+	bool empty() const { return cgroup.empty() and pid == 0; }
+};
+
+//* Returns the scope from proc_scope, "cgroup:<path>" relative to the cgroup v2 mount or "pid:<pid>"
+const collect_scope& current_scope() {
+	static string text;
+	static collect_scope scope;
+	const auto& value = Config::getS("proc_scope");
+	if (value == text) return scope;
+	text = value;
+	scope = {};
+	if (value.starts_with("pid:")) {
+		std::from_chars(value.data() + 4, value.data() + value.size(), scope.pid);
+	}
+	else if (value.starts_with("cgroup:")) {
+		string path = value.substr(7);
+		const auto& root = cgroup2_root();
+		if (root.empty()) {
+			Logger::warning("proc_scope: no cgroup v2 hierarchy mounted, collecting all processes");
+			return scope;
+		}
+		while (path.ends_with('/')) path.pop_back();
+		if (not path.starts_with(root)) path = root + (path.starts_with('/') ? "" : "/") + path;
+		scope.cgroup = path;
+	}
+	return scope;
+}
+
+//* Replaces <out> with the pids in <scope>, reading only the cgroup.procs files of the scoped cgroups or the children files
+//* of the scoped processes. Returns false if the scope can't be listed this way and all pids need to be read instead
+bool list_scope(const collect_scope& scope, const fs::path& proc_path, vector<size_t>& out) {
+	static dir_scanner scanner;
+	static string text;
+	out.clear();
+	if (not scope.cgroup.empty()) {
+		vector<string> dirs{scope.cgroup};
+		for (size_t i = 0; i < dirs.size(); i++) {
+			const int dir_fd = open(dirs[i].c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+			if (dir_fd < 0) continue;
+			if (read_at(dir_fd, "cgroup.procs", text)) parse_numbers(text, out);
+			const string base = dirs[i];
+			scanner.each(dir_fd, [&](std::string_view name, unsigned char type) {
+				if (type == DT_DIR) dirs.push_back(base + '/' + string{name});
+			});
+			close(dir_fd);
+		}
+	}
+	else {
+		//? /proc/[pid]/task/[tid]/children lists the children started by each thread
+		vector<size_t> tids;
+		out.push_back(scope.pid);
+		for (size_t i = 0; i < out.size(); i++) {
+			const int task_fd = open(fmt::format("{}/{}/task", proc_path.string(), out[i]).c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+			if (task_fd < 0) {
+				if (i == 0) out.clear();
+				continue;
+			}
+			tids.clear();
+			scanner.numeric(task_fd, tids);
+			for (const auto tid : tids) {
+				if (read_at(task_fd, fmt::format("{}/children", tid).c_str(), text)) parse_numbers(text, out);
+				else if (errno == ENOENT and tid == out[i] and i == 0) {
+					//? Kernels built without CONFIG_PROC_CHILDREN don't have the children files
+					close(task_fd);
+					return false;
+				}
+			}
+			close(task_fd);
+		}
+	}
+	rng::sort(out);
+	return true;
+}
+
 }
 
 namespace Cpu {
@@ -469,12 +675,11 @@ namespace Cpu {
 				getline(cpuinfo, name);
 			}
 			else if (fs::exists("/sys/devices")) {
-				for (const auto& d : fs::directory_iterator("/sys/devices")) {
-					if (string(d.path().filename()).starts_with("arm")) {
-						name = d.path().filename();
-						break;
-					}
-				}
+				dir_scanner{}.each("/sys/devices", [&name](std::string_view entry, unsigned char) {
+					if (not entry.starts_with("arm")) return true;
+					name = entry;
+					return false;
+				});
 				if (not name.empty()) {
 					auto name_vec = ssplit(name, '_');
 					if (name_vec.size() < 2) return capitalize(name);
@@ -494,58 +699,56 @@ namespace Cpu {
 		vector<fs::path> search_paths;
 		try {
 			//? Setup up paths to search for sensors
+			//? One scanner per nesting level, names from a scanner are only valid until it is used again
+			array<dir_scanner, 3> scanners;
+			const auto is_temp_input = [](std::string_view filename) { return filename.starts_with("temp") and filename.ends_with("_input"); };
 			if (fs::exists(fs::path("/sys/class/hwmon")) and access("/sys/class/hwmon", R_OK) != -1) {
-				for (const auto& dir : fs::directory_iterator(fs::path("/sys/class/hwmon"))) {
-					fs::path add_path = fs::canonical(dir.path());
-					if (v_contains(search_paths, add_path) or v_contains(search_paths, add_path / "device")) continue;
+				scanners[0].each("/sys/class/hwmon", [&](std::string_view dir, unsigned char) {
+					fs::path add_path = fs::canonical(fs::path("/sys/class/hwmon") / dir);
+					if (v_contains(search_paths, add_path) or v_contains(search_paths, add_path / "device")) return;
 
 					if (std::string_view { add_path.c_str() }.contains("coretemp"))
 						got_coretemp = true;
 
-					for (const auto & file : fs::directory_iterator(add_path)) {
-						if (file.path().filename() == "device") {
-							for (const auto & dev_file : fs::directory_iterator(file.path())) {
-								string dev_filename = dev_file.path().filename();
-								if (dev_filename.starts_with("temp") and dev_filename.ends_with("_input")) {
-									search_paths.push_back(file.path());
-									break;
-								}
-							}
+					scanners[1].each(add_path.c_str(), [&](std::string_view filename, unsigned char) {
+						if (filename == "device") {
+							const fs::path dev_path = add_path / filename;
+							scanners[2].each(dev_path.c_str(), [&](std::string_view dev_filename, unsigned char) {
+								if (not is_temp_input(dev_filename)) return true;
+								search_paths.push_back(dev_path);
+								return false;
+							});
 						}
 
-						string filename = file.path().filename();
-						if (filename.starts_with("temp") and filename.ends_with("_input")) {
-							search_paths.push_back(add_path);
-							break;
-						}
-					}
-				}
+						if (not is_temp_input(filename)) return true;
+						search_paths.push_back(add_path);
+						return false;
+					});
+				});
 			}
 			if (not got_coretemp and fs::exists(fs::path("/sys/devices/platform/coretemp.0/hwmon"))) {
-				for (auto& d : fs::directory_iterator(fs::path("/sys/devices/platform/coretemp.0/hwmon"))) {
-					fs::path add_path = fs::canonical(d.path());
-
-					for (const auto & file : fs::directory_iterator(add_path)) {
-						string filename = file.path().filename();
-						if (filename.starts_with("temp") and filename.ends_with("_input") and not v_contains(search_paths, add_path)) {
-								search_paths.push_back(add_path);
-								got_coretemp = true;
-								break;
-						}
-					}
-				}
+				scanners[0].each("/sys/devices/platform/coretemp.0/hwmon", [&](std::string_view dir, unsigned char) {
+					fs::path add_path = fs::canonical(fs::path("/sys/devices/platform/coretemp.0/hwmon") / dir);
+
+					scanners[1].each(add_path.c_str(), [&](std::string_view filename, unsigned char) {
+						if (not is_temp_input(filename) or v_contains(search_paths, add_path)) return true;
+						search_paths.push_back(add_path);
+						got_coretemp = true;
+						return false;
+					});
+				});
 			}
 			//? Scan any found directories for temperature sensors
 			if (not search_paths.empty()) {
 				for (const auto& path : search_paths) {
 					const string pname = readfile(path / "name", path.filename());
-					for (const auto & file : fs::directory_iterator(path)) {
+					scanners[0].each(path.c_str(), [&](std::string_view filename, unsigned char) {
 						const string file_suffix = "input";
-						const int file_id = atoi(file.path().filename().c_str() + 4); // skip "temp" prefix
-						string file_path = file.path();
+						const int file_id = filename.size() > 4 ? atoi(filename.data() + 4) : 0; // skip "temp" prefix
+						string file_path = path / filename;
 
 						if (!file_path.contains(file_suffix) or file_path.contains("nvme")) {
-							continue;
+							return;
 						}
 
 						const string basepath = file_path.erase(file_path.find(file_suffix), file_suffix.length());
@@ -564,7 +767,7 @@ namespace Cpu {
 							got_coretemp = true;
 							if (not v_contains(core_sensors, sensor_name)) core_sensors.push_back(sensor_name);
 						}
-					}
+					});
 				}
 			}
 			//? If no good candidate for cpu temp has been found scan /sys/class/thermal
@@ -841,22 +1044,26 @@ namespace Cpu {
 		if (batteries.empty() and has_battery) {
 			try {
 				if (fs::exists("/sys/class/power_supply")) {
-					for (const auto& d : fs::directory_iterator("/sys/class/power_supply")) {
+					vector<fs::path> supplies;
+					dir_scanner{}.each("/sys/class/power_supply", [&supplies](std::string_view name, unsigned char) {
+						supplies.push_back(fs::path("/sys/class/power_supply") / name);
+					});
+					for (const auto& supply : supplies) {
 						//? Only consider online power supplies of type Battery or UPS
 						//? see kernel docs for details on the file structure and contents
 						//? https://www.kernel.org/doc/Documentation/ABI/testing/sysfs-class-power
 						battery new_bat;
 						fs::path bat_dir;
 						try {
-							if (not d.is_directory()
-								or not fs::exists(d.path() / "type")
-								or not fs::exists(d.path() / "present")
-								or stoi(readfile(d.path() / "present")) != 1)
+							if (not fs::is_directory(supply)
+								or not fs::exists(supply / "type")
+								or not fs::exists(supply / "present")
+								or stoi(readfile(supply / "present")) != 1)
 								continue;
-							string dev_type = readfile(d.path() / "type");
+							string dev_type = readfile(supply / "type");
 							if (is_in(dev_type, "Battery", "UPS")) {
-								bat_dir = d.path();
-								new_bat.base_dir = d.path();
+								bat_dir = supply;
+								new_bat.base_dir = supply;
 								new_bat.device_type = dev_type;
 							}
 						} catch (...) {
@@ -1101,6 +1308,41 @@ namespace Cpu {
                std::views::join | std::ranges::to<std::vector<std::int32_t>>();
     }
 
+	//* Cpu usage of the scoped cgroup in percent of its cpu.max quota or of all cores, -1 if the box isn't scoped to a cgroup
+	static long long scope_cpu_percent() {
+		static uint64_t last_usage{};
+		static long long last_time{};
+		static string last_cgroup, text;
+		const auto& scope = current_scope();
+		if (scope.cgroup.empty() or not Config::getB("proc_scope_boxes")) {
+			last_time = 0;
+			return -1;
+		}
+		const int dir_fd = open(scope.cgroup.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+		if (dir_fd < 0) return -1;
+		uint64_t usage{};
+		double cores = Shared::coreCount;
+		if (read_at(dir_fd, "cpu.stat", text)) {
+			if (const auto pos = text.find("usage_usec "); pos != string::npos)
+				std::from_chars(text.data() + pos + 11, text.data() + text.size(), usage);
+		}
+		if (read_at(dir_fd, "cpu.max", text) and not text.starts_with("max")) {
+			vector<size_t> quota;
+			parse_numbers(text, quota);
+			if (quota.size() == 2 and quota[0] > 0 and quota[1] > 0) cores = min(cores, static_cast<double>(quota[0]) / quota[1]);
+		}
+		close(dir_fd);
+
+		const long long now = get_monotonicTimeUSec();
+		long long percent = 0;
+		if (last_time > 0 and scope.cgroup == last_cgroup and usage >= last_usage and now > last_time)
+			percent = clamp(std::llround((usage - last_usage) * 100.0 / ((now - last_time) * cores)), 0ll, 100ll);
+		last_usage = usage;
+		last_time = now;
+		last_cgroup = scope.cgroup;
+		return percent;
+	}
+
 	auto collect(bool no_update) -> cpu_info& {
 		if (Runner::stopping or (no_update and not current_cpu.cpu_percent.at("total").empty())) return current_cpu;
 		auto& cpu = current_cpu;
@@ -1178,8 +1420,9 @@ namespace Cpu {
 						cpu_old.at("totals") = totals;
 						cpu_old.at("idles") = idles;
 
-						//? Total usage of cpu
+						//? Total usage of cpu, or of the scoped cgroup
 						cpu.cpu_percent.at("total").push_back(clamp((long long)round((double)(calc_totals - calc_idles) * 100 / calc_totals), 0ll, 100ll));
+						if (const auto scoped = scope_cpu_percent(); scoped >= 0) cpu.cpu_percent.at("total").back() = scoped;
 
 						//? Reduce size if there are more values than needed for graph
 						while (cmp_greater(cpu.cpu_percent.at("total").size(), width * 2)) cpu.cpu_percent.at("total").pop_front();
@@ -2405,9 +2648,42 @@ namespace Mem {
 
 		meminfo.close();
 
+		//? With a cgroup scope the memory values are those of the cgroup, relative to its memory.max limit if it has one
+		mem.scope_total = 0;
+		if (const auto& scope = current_scope(); not scope.cgroup.empty() and Config::getB("proc_scope_boxes")) {
+			if (const int dir_fd = open(scope.cgroup.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC); dir_fd >= 0) {
+				static string text;
+				vector<size_t> values;
+				if (read_at(dir_fd, "memory.current", text)) parse_numbers(text, values);
+				if (values.size() == 1) {
+					const uint64_t current = values[0];
+					uint64_t limit = totalMem, file{}, inactive_file{};
+					values.clear();
+					if (read_at(dir_fd, "memory.max", text)) parse_numbers(text, values);
+					if (values.size() == 1 and values[0] > 0) limit = min<uint64_t>(values[0], totalMem);
+					if (read_at(dir_fd, "memory.stat", text)) {
+						for (const auto line : text | std::views::split('\n')) {
+							const std::string_view entry{line.begin(), line.end()};
+							if (entry.starts_with("file ")) std::from_chars(entry.data() + 5, entry.data() + entry.size(), file);
+							else if (entry.starts_with("inactive_file ")) std::from_chars(entry.data() + 14, entry.data() + entry.size(), inactive_file);
+						}
+					}
+					//? Inactive page cache can be reclaimed, so it isn't counted as used, the same way docker and systemd report it
+					const uint64_t used = min(current - min(inactive_file, current), limit);
+					mem.stats.at("used") = used;
+					mem.stats.at("available") = limit - used;
+					mem.stats.at("free") = limit - min(current, limit);
+					mem.stats.at("cached") = min(file, limit);
+					mem.scope_total = limit;
+				}
+				close(dir_fd);
+			}
+		}
+		const uint64_t mem_total = (mem.scope_total > 0 ? mem.scope_total : totalMem);
+
 		//? Calculate percentages
 		for (const auto& name : mem_names) {
-			mem.percent.at(name).push_back(round((double)mem.stats.at(name) * 100 / totalMem));
+			mem.percent.at(name).push_back(round((double)mem.stats.at(name) * 100 / mem_total));
 			while (cmp_greater(mem.percent.at(name).size(), width * 2)) mem.percent.at(name).pop_front();
 		}
 
@@ -2756,7 +3032,6 @@ namespace Mem {
 		}
 
 		ifstream filestream;
-		string filename;
 		string name_compare;
 
 		if (dataset_name_start != std::string::npos) { // device is a dataset
@@ -2767,28 +3042,29 @@ namespace Mem {
 
 		// looking through all files that start with 'objset' to find the one containing `device_name` object stats
 		try {
-			for (const auto& file: fs::directory_iterator(zfs_pool_stat_path)) {
-				filename = file.path().filename();
-				if (filename.starts_with("objset")) {
-					filestream.open(file.path());
-					if (filestream.good()) {
-						// skip first two lines
-						for (int i = 0; i < 2; i++) filestream.ignore(numeric_limits<streamsize>::max(), '\n');
-						// skip characters until '7' is reached, indicating data type 7, next value will be object name
-						filestream.ignore(numeric_limits<streamsize>::max(), '7');
-						filestream >> name_compare;
-						if (name_compare == device_name) {
-							filestream.close();
-							if (access(file.path().c_str(), R_OK) == 0) {
-								return file.path();
-							} else {
-								Logger::debug("Can't access file: {}", file.path());
-								return "";
-							}
+			vector<fs::path> objsets;
+			dir_scanner{}.each(zfs_pool_stat_path.c_str(), [&](std::string_view name, unsigned char) {
+				if (name.starts_with("objset")) objsets.push_back(zfs_pool_stat_path / name);
+			});
+			for (const auto& file: objsets) {
+				filestream.open(file);
+				if (filestream.good()) {
+					// skip first two lines
+					for (int i = 0; i < 2; i++) filestream.ignore(numeric_limits<streamsize>::max(), '\n');
+					// skip characters until '7' is reached, indicating data type 7, next value will be object name
+					filestream.ignore(numeric_limits<streamsize>::max(), '7');
+					filestream >> name_compare;
+					if (name_compare == device_name) {
+						filestream.close();
+						if (access(file.c_str(), R_OK) == 0) {
+							return file;
+						} else {
+							Logger::debug("Can't access file: {}", file);
+							return "";
 						}
 					}
-					filestream.close();
 				}
+				filestream.close();
 			}
 		}
 		catch (fs::filesystem_error& e) {}
@@ -2809,43 +3085,48 @@ namespace Mem {
 		int64_t objects_read{};
 
 		// looking through all files that start with 'objset'
-		for (const auto& file: fs::directory_iterator(disk.stat)) {
-			if ((file.path().filename()).string().starts_with("objset")) {
-				diskread.open(file.path());
-				if (diskread.good()) {
-					try {
-						// skip first three lines
-						for (int i = 0; i < 3; i++) diskread.ignore(numeric_limits<streamsize>::max(), '\n');
-						// skip characters until '4' is reached, indicating data type 4, next value will be out target
-						diskread.ignore(numeric_limits<streamsize>::max(), '4');
-						diskread >> io_ticks;
-						io_ticks_total += io_ticks;
-
-						// skip characters until '4' is reached, indicating data type 4, next value will be out target
-						diskread.ignore(numeric_limits<streamsize>::max(), '4');
-						diskread >> bytes_write;
-						bytes_write_total += bytes_write;
-
-						// skip characters until '4' is reached, indicating data type 4, next value will be out target
-						diskread.ignore(numeric_limits<streamsize>::max(), '4');
-						diskread >> io_ticks;
-						io_ticks_total += io_ticks;
-
-						// skip characters until '4' is reached, indicating data type 4, next value will be out target
-						diskread.ignore(numeric_limits<streamsize>::max(), '4');
-						diskread >> bytes_read;
-						bytes_read_total += bytes_read;
-					} catch (const std::exception& e) {
-						continue;
-					}
-
-					// increment read objects counter if no errors were encountered
-					objects_read++;
-				} else {
-					Logger::debug("Could not read file: {}", file.path());
+		static dir_scanner objset_scanner;
+		static vector<string> objsets;
+		objsets.clear();
+		objset_scanner.each(disk.stat.c_str(), [](std::string_view name, unsigned char) {
+			if (name.starts_with("objset")) objsets.emplace_back(name);
+		});
+		for (const auto& name : objsets) {
+			const fs::path file = disk.stat / name;
+			diskread.open(file);
+			if (diskread.good()) {
+				try {
+					// skip first three lines
+					for (int i = 0; i < 3; i++) diskread.ignore(numeric_limits<streamsize>::max(), '\n');
+					// skip characters until '4' is reached, indicating data type 4, next value will be out target
+					diskread.ignore(numeric_limits<streamsize>::max(), '4');
+					diskread >> io_ticks;
+					io_ticks_total += io_ticks;
+
+					// skip characters until '4' is reached, indicating data type 4, next value will be out target
+					diskread.ignore(numeric_limits<streamsize>::max(), '4');
+					diskread >> bytes_write;
+					bytes_write_total += bytes_write;
+
+					// skip characters until '4' is reached, indicating data type 4, next value will be out target
+					diskread.ignore(numeric_limits<streamsize>::max(), '4');
+					diskread >> io_ticks;
+					io_ticks_total += io_ticks;
+
+					// skip characters until '4' is reached, indicating data type 4, next value will be out target
+					diskread.ignore(numeric_limits<streamsize>::max(), '4');
+					diskread >> bytes_read;
+					bytes_read_total += bytes_read;
+				} catch (const std::exception& e) {
+					continue;
 				}
-				diskread.close();
+
+				// increment read objects counter if no errors were encountered
+				objects_read++;
+			} else {
+				Logger::debug("Could not read file: {}", file);
 			}
+			diskread.close();
 		}
 
 		// if for some reason no objects were read
@@ -3085,7 +3366,6 @@ namespace Net {
 namespace Proc {
 
 	vector<proc_info> current_procs;
-	std::unordered_map<string, string> uid_user;
 	string current_sort;
 	string current_filter;
 	bool current_rev{};
@@ -3104,172 +3384,1558 @@ namespace Proc {
 	static std::unordered_set<size_t> kernels_procs = {KTHREADD};
 	static std::unordered_set<size_t> dead_procs;
 
-	//* Get detailed info for selected process
-	static void _collect_details(const size_t pid, const uint64_t uptime, vector<proc_info>& procs) {
-		fs::path pid_path = Shared::procPath / std::to_string(pid);
+	//* Maps pid to position in current_procs, new pids are added as they are found and positions are refreshed after reordering
+	static std::unordered_map<size_t, size_t> pid_index;
 
-		if (pid != detailed.last_pid) {
-			detailed = {};
-			detailed.last_pid = pid;
-			detailed.skip_smaps = not Config::getB("proc_info_smaps");
+	//* Refresh positions in pid_index after current_procs has been sorted or had dead processes removed
+	static void reindex_procs() {
+		for (size_t i = 0; const auto& p : current_procs) {
+			pid_index[p.pid] = i++;
 		}
+	}
 
-		//? Copy proc_info for process from proc vector
-		auto p_info = rng::find(procs, pid, &proc_info::pid);
-		detailed.entry = *p_info;
+	//* Parent to children links of current_procs for tree mode, patched during collection for processes that started,
+	//* exited or got a new parent, and only rebuilt when entering tree mode
+	static tree_adjacency tree_links;
+
+	//* Stable sort of current_procs by tree_index in linear time
+	static void sort_by_tree_index() {
+		const size_t procs = current_procs.size();
+		//? Processes that were not reached when generating the tree while paused can have an outdated tree_index
+		if (rng::any_of(current_procs, [procs](const auto& p) { return p.tree_index > procs; })) {
+			rng::stable_sort(current_procs, rng::less{}, &proc_info::tree_index);
+			return;
+		}
+		static vector<size_t> offsets;
+		static vector<proc_info> sorted;
+		offsets.assign(procs + 2, 0);
+		for (const auto& p : current_procs) offsets[p.tree_index + 1]++;
+		std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+		sorted.resize(procs);
+		for (auto& p : current_procs) sorted[offsets[p.tree_index]++] = std::move(p);
+		current_procs.swap(sorted);
+	}
 
-		//? Update cpu percent deque for process cpu graph
-		if (not Config::getB("proc_per_core")) detailed.entry.cpu_p *= Shared::coreCount;
-		detailed.cpu_percent.push_back(clamp((long long)round(detailed.entry.cpu_p), 0ll, 100ll));
-		while (cmp_greater(detailed.cpu_percent.size(), width)) detailed.cpu_percent.pop_front();
+	//* Cpu time of children reaped by each process since last update, only tracked when proc_events is enabled
+	static std::unordered_map<size_t, uint64_t> children_time;
 
-		//? Process runtime
-		if (detailed.entry.state != 'X') detailed.elapsed = sec_to_dhms(uptime - (detailed.entry.cpu_s / Shared::clkTck));
-		else detailed.elapsed = sec_to_dhms(detailed.entry.death_time);
-		if (detailed.elapsed.size() > 8) detailed.elapsed.resize(detailed.elapsed.size() - 3);
+	//* Pids that called exec since last update according to the proc connector, their name, command and user are read again
+	static std::unordered_set<size_t> exec_pids;
 
-		//? Get parent process name
-		if (detailed.parent.empty()) {
-			auto p_entry = rng::find(procs, detailed.entry.ppid, &proc_info::pid);
-			if (p_entry != procs.end()) detailed.parent = p_entry->name;
+	//* Hot/cold tiering, processes whose cpu time and memory didn't change for cold_after reads are moved to the cold tier
+	//* and only read every proc_cold_interval updates until they change again
+	constexpr int cold_after = 5;
+	struct tier_state {
+		int idle{};				//? Consecutive reads without changes, capped at cold_after
+		uint64_t cputimes{};	//? Total cpu time from /proc/stat when the process was last read
+
+		bool cold() const { return idle >= cold_after; }
+	};
+	static std::unordered_map<size_t, tier_state> tiers;
+
+	//* File descriptor for the /proc directory, all per pid files are opened relative to it with openat()
+	static int proc_fd = -1;
+
+	//* Fields parsed from /proc/[pid]/stat, indexed by the field numbers used in `man 5 proc`
+	struct stat_fields {
+		std::string_view comm;
+		char state = '0';
+		array<int64_t, 25> field{};
+
+		int64_t operator[](size_t index) const { return field[index]; }
+	};
+
+	//* Write "<pid>/<file>" into <buf> for use with openat() relative to proc_fd
+	static const char* pid_path(array<char, 64>& buf, size_t pid, std::string_view file) {
+		auto [end, ec] = std::to_chars(buf.data(), buf.data() + 24, pid);
+		*end++ = '/';
+		const auto len = min(file.size(), static_cast<size_t>(buf.data() + buf.size() - end - 1));
+		std::memcpy(end, file.data(), len);
+		end[len] = '\0';
+		return buf.data();
+	}
+
+	//* Number of syscalls used for reading files in /proc during the current collect
+	static atomic<long long> read_syscalls{};
+
+	//* Set when io_uring could not be used, reads stay synchronous until proc_io_uring is toggled
+	static atomic<bool> uring_failed{};
+
+	//* Counts syscalls used for reading /proc and context switches of btop while in scope, shown in the debug overlay
+	class collect_counters {
+		long long switches_before;
+
+		static long long context_switches() {
+			struct rusage usage{};
+			getrusage(RUSAGE_SELF, &usage);
+			return usage.ru_nvcsw + usage.ru_nivcsw;
 		}
 
-		//? Expand process status from single char to explanative string
-		detailed.status = (proc_states.contains(detailed.entry.state)) ? proc_states.at(detailed.entry.state) : "Unknown";
+	public:
+		collect_counters() : switches_before(context_switches()) { read_syscalls = 0; }
+		~collect_counters() {
+			collect_syscalls = read_syscalls.load();
+			collect_switches = context_switches() - switches_before;
+		}
+	};
 
-		ifstream d_read;
-		string short_str;
+	//* Read up to buf.size() bytes from <path> relative to <dir_fd> without any heap allocations
+	//* Returns a view of the data read, or an empty view on failure
+	static std::string_view read_at(int dir_fd, const char* path, std::span<char> buf) {
+		const int fd = openat(dir_fd, path, O_RDONLY | O_CLOEXEC);
+		if (fd < 0) {
+			read_syscalls.fetch_add(1, std::memory_order_relaxed);
+			return {};
+		}
+		size_t total = 0;
+		long long calls = 2;
+		while (total < buf.size()) {
+			const ssize_t n = read(fd, buf.data() + total, buf.size() - total);
+			calls++;
+			if (n < 0 and errno == EINTR) continue;
+			if (n <= 0) break;
+			total += n;
+		}
+		close(fd);
+		read_syscalls.fetch_add(calls, std::memory_order_relaxed);
+		return {buf.data(), total};
+	}
 
-		//? Try to get RSS mem from proc/[pid]/smaps
-		detailed.memory.clear();
-		if (not detailed.skip_smaps and fs::exists(pid_path / "smaps")) {
-			d_read.open(pid_path / "smaps");
-			uint64_t rss = 0;
-			try {
-				while (d_read.good()) {
-					d_read.ignore(SSmax, 'R');
-					if (d_read.peek() == 's') {
-						d_read.ignore(SSmax, ':');
-						getline(d_read, short_str, 'k');
-						rss += stoull(short_str);
-					}
-				}
-				if (rss == detailed.entry.mem >> 10)
-					detailed.skip_smaps = true;
-				else {
-					detailed.mem_bytes.push_back(rss << 10);
-					detailed.memory = floating_humanizer(rss, false, 1);
-				}
+	//* Open /proc/[pid] files kept between updates, so long lived processes are read with a single pread()
+	//* The number of cached descriptors is limited to proc_fd_budget percent of the soft open file limit,
+	//* pids are split over shards with their own lock since the scan threads look up descriptors concurrently
+	class pid_fd_cache {
+		struct shard {
+			std::mutex lock;
+			std::unordered_map<size_t, int> fds;
+		};
+		array<shard, 16> shards;
+		atomic<size_t> count{};
+		size_t budget{};
+		int budget_percent = -1;
+
+		shard& shard_of(size_t pid) { return shards[pid % shards.size()]; }
+
+	public:
+		~pid_fd_cache() { clear(); }
+
+		//* Set the budget to <percent> of the current RLIMIT_NOFILE soft limit, the limit itself is left as is
+		void set_budget(int percent) {
+			if (percent == budget_percent) return;
+			budget_percent = percent;
+			struct rlimit limit{};
+			if (percent <= 0 or getrlimit(RLIMIT_NOFILE, &limit) != 0) {
+				budget = 0;
+				clear();
+				return;
 			}
-			catch (const std::invalid_argument&) {}
-			catch (const std::out_of_range&) {}
-			d_read.close();
+			budget = static_cast<size_t>(min<rlim_t>(limit.rlim_cur, 1 << 20) * percent / 100);
 		}
-		if (detailed.memory.empty()) {
-			detailed.mem_bytes.push_back(detailed.entry.mem);
-			detailed.memory = floating_humanizer(detailed.entry.mem);
+
+		//* Cached descriptor for <pid> or -1
+		int find(size_t pid) {
+			auto& sh = shard_of(pid);
+			std::lock_guard lock(sh.lock);
+			const auto it = sh.fds.find(pid);
+			return it == sh.fds.end() ? -1 : it->second;
 		}
-		if (detailed.first_mem == -1 or detailed.first_mem < detailed.mem_bytes.back() / 2 or detailed.first_mem > detailed.mem_bytes.back() * 4) {
-			detailed.first_mem = min((uint64_t)detailed.mem_bytes.back() * 2, Mem::get_totalMem());
-			redraw = true;
+
+		//* Cache <fd> for <pid>, returns false if the budget is used up and the caller keeps ownership of <fd>
+		bool insert(size_t pid, int fd) {
+			if (count.fetch_add(1, std::memory_order_relaxed) >= budget) {
+				count.fetch_sub(1, std::memory_order_relaxed);
+				return false;
+			}
+			auto& sh = shard_of(pid);
+			std::lock_guard lock(sh.lock);
+			sh.fds.emplace(pid, fd);
+			return true;
 		}
 
-		while (cmp_greater(detailed.mem_bytes.size(), width)) detailed.mem_bytes.pop_front();
+		//* Close the descriptor of <pid>, used when the process has exited
+		void erase(size_t pid) {
+			auto& sh = shard_of(pid);
+			std::lock_guard lock(sh.lock);
+			if (const auto it = sh.fds.find(pid); it != sh.fds.end()) {
+				close(it->second);
+				sh.fds.erase(it);
+				count.fetch_sub(1, std::memory_order_relaxed);
+			}
+		}
 
-		//? Get bytes read and written from proc/[pid]/io
-		if (fs::exists(pid_path / "io")) {
-			d_read.open(pid_path / "io");
-			try {
-				string name;
-				while (d_read.good()) {
-					getline(d_read, name, ':');
-					if (name.ends_with("read_bytes")) {
-						getline(d_read, short_str);
-						detailed.io_read = floating_humanizer(stoull(short_str));
-					}
-					else if (name.ends_with("write_bytes")) {
-						getline(d_read, short_str);
-						detailed.io_write = floating_humanizer(stoull(short_str));
-						break;
-					}
-					else
-						d_read.ignore(SSmax, '\n');
-				}
+		//* Close descriptors of pids not in <live>, only called while no scan is running
+		void prune(const std::unordered_set<size_t>& live) {
+			for (auto& sh : shards) {
+				std::lock_guard lock(sh.lock);
+				std::erase_if(sh.fds, [&](const auto& entry) {
+					if (live.contains(entry.first)) return false;
+					close(entry.second);
+					count.fetch_sub(1, std::memory_order_relaxed);
+					return true;
+				});
 			}
-			catch (const std::invalid_argument&) {}
-			catch (const std::out_of_range&) {}
-			d_read.close();
 		}
-	}
 
-	//* Collects and sorts process information from /proc
-	auto collect(bool no_update) -> vector<proc_info>& {
-		if (Runner::stopping) return current_procs;
-		const auto& sorting = Config::getS("proc_sorting");
-		auto reverse = Config::getB("proc_reversed");
-		const auto& filter = Config::getS("proc_filter");
-		auto per_core = Config::getB("proc_per_core");
-		auto should_filter_kernel = Config::getB("proc_filter_kernel");
-		auto tree = Config::getB("proc_tree");
-		auto show_detailed = Config::getB("show_detailed");
-		const auto pause_proc_list = Config::getB("pause_proc_list");
-		const size_t detailed_pid = Config::getI("detailed_pid");
-		bool should_filter = current_filter != filter;
-		if (should_filter) current_filter = filter;
-		bool sorted_change = (sorting != current_sort or reverse != current_rev or should_filter);
-		bool tree_mode_change = tree != is_tree_mode;
-		if (sorted_change) {
-			current_sort = sorting;
-			current_rev = reverse;
+		void clear() {
+			for (auto& sh : shards) {
+				std::lock_guard lock(sh.lock);
+				for (const auto& [pid, fd] : sh.fds) close(fd);
+				sh.fds.clear();
+			}
+			count = 0;
 		}
-		if (tree_mode_change) is_tree_mode = tree;
-		ifstream pread;
-		string long_string;
-		string short_str;
 
-		static vector<size_t> found;
+		size_t size() const { return count.load(std::memory_order_relaxed); }
+	};
 
-		const double uptime = system_uptime();
+	//* Descriptors for /proc/[pid]/stat, for /proc/[pid]/schedstat when proc_schedstat is enabled and for /proc/[pid]/io when proc_io is enabled
+	static pid_fd_cache stat_fds, schedstat_fds, io_fds;
+
+	//* Read /proc/[pid]/<file> into <buf> through the descriptor <cache>, a cached descriptor of an exited process
+	//* fails with ESRCH and is replaced by opening the path again, which also covers pids reused by a new process
+	static std::string_view read_cached(pid_fd_cache& cache, size_t pid, std::string_view file, array<char, 64>& path_buf, std::span<char> buf) {
+		if (const int fd = cache.find(pid); fd >= 0) {
+			const ssize_t len = pread(fd, buf.data(), buf.size(), 0);
+			read_syscalls.fetch_add(1, std::memory_order_relaxed);
+			if (len > 0) return {buf.data(), static_cast<size_t>(len)};
+			cache.erase(pid);
+		}
+		const int fd = openat(proc_fd, pid_path(path_buf, pid, file), O_RDONLY | O_CLOEXEC);
+		if (fd < 0) {
+			read_syscalls.fetch_add(1, std::memory_order_relaxed);
+			return {};
+		}
+		const ssize_t len = pread(fd, buf.data(), buf.size(), 0);
+		const bool cached = len > 0 and cache.insert(pid, fd);
+		if (not cached) close(fd);
+		read_syscalls.fetch_add(cached ? 2 : 3, std::memory_order_relaxed);
+		return len > 0 ? std::string_view{buf.data(), static_cast<size_t>(len)} : std::string_view{};
+	}
 
-		const int cmult = (per_core) ? Shared::coreCount : 1;
-		bool got_detailed = false;
+#if defined(IORING_SETUP_SUBMIT_ALL)
+	//* Reads the same file for a batch of pids with io_uring, every file is opened, read and closed by three linked requests
+	//* using direct descriptors, so a batch costs a single io_uring_enter() call instead of at least four syscalls per file
+	class uring_reader {
+		int ring_fd = -1;
+		void* sq_ring = MAP_FAILED;
+		void* cq_ring = MAP_FAILED;
+		size_t sq_ring_size{}, cq_ring_size{}, sqes_size{};
+		io_uring_sqe* sqes = static_cast<io_uring_sqe*>(MAP_FAILED);
+		unsigned *sq_tail{}, *sq_mask{}, *sq_array{};
+		unsigned *cq_head{}, *cq_tail{}, *cq_mask{};
+		io_uring_cqe* cqes{};
+
+	public:
+		static constexpr unsigned batch_size = 64;
+
+	private:
+		array<array<char, 64>, batch_size> paths;
+
+		void stop() {
+			if (sqes != MAP_FAILED) munmap(sqes, sqes_size);
+			if (cq_ring != MAP_FAILED and cq_ring != sq_ring) munmap(cq_ring, cq_ring_size);
+			if (sq_ring != MAP_FAILED) munmap(sq_ring, sq_ring_size);
+			if (ring_fd >= 0) close(ring_fd);
+			ring_fd = -1;
+			sq_ring = cq_ring = MAP_FAILED;
+			sqes = static_cast<io_uring_sqe*>(MAP_FAILED);
+		}
 
-		static size_t proc_clear_count{};
+	public:
+		uring_reader() = default;
+		~uring_reader() { stop(); }
+		uring_reader(const uring_reader&) = delete;
+		uring_reader& operator=(const uring_reader&) = delete;
+
+		bool active() const { return ring_fd >= 0; }
+
+		//* Set up the rings and a table of direct descriptors, returns false and sets errno if io_uring is
+		//* not available, blocked by seccomp or a container runtime, or the kernel is older than 5.15
+		bool start() {
+			io_uring_params params{};
+			ring_fd = static_cast<int>(syscall(__NR_io_uring_setup, batch_size * 3, &params));
+			if (ring_fd < 0) return false;
+
+			sq_ring_size = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+			cq_ring_size = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+			if (params.features & IORING_FEAT_SINGLE_MMAP) sq_ring_size = cq_ring_size = max(sq_ring_size, cq_ring_size);
+			sqes_size = params.sq_entries * sizeof(io_uring_sqe);
+			sq_ring = mmap(nullptr, sq_ring_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring_fd, IORING_OFF_SQ_RING);
+			cq_ring = (params.features & IORING_FEAT_SINGLE_MMAP) ? sq_ring
+					: mmap(nullptr, cq_ring_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring_fd, IORING_OFF_CQ_RING);
+			sqes = static_cast<io_uring_sqe*>(mmap(nullptr, sqes_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring_fd, IORING_OFF_SQES));
+			if (sq_ring == MAP_FAILED or cq_ring == MAP_FAILED or sqes == MAP_FAILED) {
+				const int err = errno;
+				stop();
+				errno = err;
+				return false;
+			}
 
-		//* Use pids from last update if only changing filter, sorting or tree options
-		if (no_update and not current_procs.empty()) {
-			if (show_detailed and detailed_pid != detailed.last_pid) _collect_details(detailed_pid, round(uptime), current_procs);
+			auto* sq = static_cast<char*>(sq_ring);
+			auto* cq = static_cast<char*>(cq_ring);
+			sq_tail = reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+			sq_mask = reinterpret_cast<unsigned*>(sq + params.sq_off.ring_mask);
+			sq_array = reinterpret_cast<unsigned*>(sq + params.sq_off.array);
+			cq_head = reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+			cq_tail = reinterpret_cast<unsigned*>(cq + params.cq_off.tail);
+			cq_mask = reinterpret_cast<unsigned*>(cq + params.cq_off.ring_mask);
+			cqes = reinterpret_cast<io_uring_cqe*>(cq + params.cq_off.cqes);
+
+			//? Sparse table of direct descriptors, one slot for each pid in a batch
+			array<int, batch_size> files;
+			files.fill(-1);
+			if (syscall(__NR_io_uring_register, ring_fd, IORING_REGISTER_FILES, files.data(), batch_size) < 0) {
+				const int err = errno;
+				stop();
+				errno = err;
+				return false;
+			}
+			return true;
 		}
-		//* ---------------------------------------------Collection start----------------------------------------------
-		else {
-			should_filter = true;
-			found.clear();
 
-			//? First make sure kernel proc cache is cleared.
-			if (should_filter_kernel and ++proc_clear_count >= 256) {
-				//? Clearing the cache is used in the event of a pid wrap around.
-				//? In that event processes that acquire old kernel pids would also be filtered out so we need to manually clean the cache every now and then.
-				kernels_procs.clear();
-				kernels_procs.emplace(KTHREADD);
-				proc_clear_count = 0;
-			}
+		//* Read <file> of every pid in <pids> into consecutive <slot_size> chunks of <buf>, <sizes> receives the number of
+		//* bytes read for each pid or -1 if the pid is gone. Returns false and sets errno if the batch could not be completed
+		bool read(std::span<const size_t> pids, std::string_view file, std::span<char> buf, size_t slot_size, std::span<int> sizes) {
+			const auto count = static_cast<unsigned>(min<size_t>(pids.size(), batch_size));
+			unsigned tail = *sq_tail;
+			const auto queue = [&](unsigned index, uint8_t opcode, uint8_t flags) -> io_uring_sqe& {
+				const unsigned slot = tail++ & *sq_mask;
+				sq_array[slot] = slot;
+				auto& sqe = sqes[slot];
+				sqe = {};
+				sqe.opcode = opcode;
+				sqe.flags = flags;
+				sqe.user_data = index;
+				return sqe;
+			};
 
-			auto totalMem = Mem::get_totalMem();
-			int totalMem_len = to_string(totalMem >> 10).size();
+			for (unsigned i = 0; i < count; i++) {
+				//? open -> read -> close, a failed open cancels the read while the hard link always runs the close
+				auto& open_sqe = queue(i * 3, IORING_OP_OPENAT, IOSQE_IO_LINK);
+				open_sqe.fd = proc_fd;
+				open_sqe.addr = reinterpret_cast<uint64_t>(pid_path(paths[i], pids[i], file));
+				open_sqe.open_flags = O_RDONLY;
+				open_sqe.file_index = i + 1;
 
-			//? Update uid_user map if /etc/passwd changed since last run
-			if (not Shared::passwd_path.empty() and fs::last_write_time(Shared::passwd_path) != passwd_time) {
-				string r_uid, r_user;
-				passwd_time = fs::last_write_time(Shared::passwd_path);
-				uid_user.clear();
-				pread.open(Shared::passwd_path);
-				if (pread.good()) {
-					while (pread.good()) {
-						getline(pread, r_user, ':');
-						pread.ignore(SSmax, ':');
+				auto& read_sqe = queue(i * 3 + 1, IORING_OP_READ, IOSQE_FIXED_FILE | IOSQE_IO_HARDLINK);
+				read_sqe.fd = static_cast<int>(i);
+				read_sqe.addr = reinterpret_cast<uint64_t>(buf.data() + i * slot_size);
+				read_sqe.len = static_cast<uint32_t>(slot_size);
+
+				auto& close_sqe = queue(i * 3 + 2, IORING_OP_CLOSE, 0);
+				close_sqe.file_index = i + 1;
+
+				sizes[i] = -1;
+			}
+			std::atomic_ref(*sq_tail).store(tail, std::memory_order_release);
+
+			unsigned pending = count * 3, to_submit = count * 3;
+			bool unsupported = false;
+			while (pending > 0) {
+				const auto submitted = syscall(__NR_io_uring_enter, ring_fd, to_submit, pending, IORING_ENTER_GETEVENTS, nullptr, 0);
+				read_syscalls.fetch_add(1, std::memory_order_relaxed);
+				if (submitted < 0 and errno != EINTR) return false;
+				if (submitted > 0) to_submit -= static_cast<unsigned>(submitted);
+
+				unsigned head = *cq_head;
+				const unsigned cq_end = std::atomic_ref(*cq_tail).load(std::memory_order_acquire);
+				for (; head != cq_end; head++, pending--) {
+					const auto& cqe = cqes[head & *cq_mask];
+					const auto index = cqe.user_data / 3;
+					switch (cqe.user_data % 3) {
+						case 0: if (cqe.res == -EINVAL or cqe.res == -EBADF) unsupported = true; break;
+						case 1: if (cqe.res >= 0) sizes[index] = cqe.res; break;
+					}
+				}
+				std::atomic_ref(*cq_head).store(head, std::memory_order_release);
+			}
+
+			//? Kernels without direct descriptors for openat reject the requests, let the caller fall back to read_at()
+			if (unsupported) {
+				errno = EINVAL;
+				return false;
+			}
+			return true;
+		}
+	};
+#endif
+
+	//* Parse the contents of /proc/[pid]/stat into <out>, returns false if the data is truncated or malformed
+	//* The comm field is delimited by the last ')' since the program name itself can contain both spaces and parentheses
+	static bool parse_stat(std::string_view data, stat_fields& out) {
+		const auto comm_start = data.find('(');
+		const auto comm_end = data.rfind(')');
+		if (comm_start == std::string_view::npos or comm_end == std::string_view::npos or comm_end < comm_start or comm_end + 4 > data.size())
+			return false;
+		out.comm = data.substr(comm_start + 1, comm_end - comm_start - 1);
+		out.state = data[comm_end + 2];
+
+		const char* pos = data.data() + comm_end + 3;
+		const char* const end = data.data() + data.size();
+		for (size_t index = 4; index < out.field.size(); index++) {
+			while (pos < end and *pos == ' ') pos++;
+			auto [next, ec] = std::from_chars(pos, end, out.field[index]);
+			if (ec != std::errc()) return false;
+			pos = next;
+		}
+		return true;
+	}
+
+	//* Threads of a process read from /proc/[pid]/task, kept between updates so the task directory is only read when needed
+	struct task_cache {
+		size_t threads{};
+		uint64_t cpu_t{};
+		vector<proc_info> tasks;	//? Sorted by thread id
+	};
+
+	//* Thread caches of multithreaded processes shown in thread mode or in the detailed view
+	static std::unordered_map<size_t, task_cache> task_caches;
+
+	//* Threads of all processes for thread mode, single threaded processes are copied as is
+	static vector<proc_info> thread_procs;
+
+	//* Update the threads of <proc> in <cache>, <cpu_ticks> is the total cpu time since last update
+	//* The task directory is only read if the thread count or cpu time of <proc> changed since it was last read,
+	//* otherwise none of the threads used any cpu time and only the values shared with <proc> are updated
+	static void scan_tasks(const proc_info& proc, task_cache& cache, uint64_t cpu_ticks, int cmult, double uptime) {
+		if (cache.tasks.empty() or cache.threads != proc.threads or cache.cpu_t != proc.cpu_t) {
+			array<char, 64> path_buf;
+			array<char, 1024> stat_buf;
+			stat_fields stat;
+			const int task_fd = openat(proc_fd, pid_path(path_buf, proc.pid, "task"), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+			if (task_fd < 0) return;
+			static thread_local dir_scanner task_scanner;
+			static thread_local vector<size_t> tids;
+			tids.clear();
+			task_scanner.numeric(task_fd, tids);
+			vector<proc_info> tasks;
+			tasks.reserve(tids.size());
+			for (const size_t tid : tids) {
+				if (not parse_stat(read_at(task_fd, pid_path(path_buf, tid, "stat"), stat_buf), stat)) continue;
+
+				auto& task = tasks.emplace_back();
+				task.pid = tid;
+				task.name = stat.comm;
+				task.state = stat.state;
+				task.p_nice = stat[19];
+				task.cpu_s = stat[22];
+				task.cpu_t = stat[14] + stat[15];
+
+				//? Thread cpu usage since last update, threads not seen before start at 0 like new processes
+				auto last = rng::lower_bound(cache.tasks, tid, rng::less{}, &proc_info::pid);
+				if (last != cache.tasks.end() and last->pid == tid and task.cpu_t > last->cpu_t)
+					task.cpu_p = clamp(round(cmult * 1000 * (task.cpu_t - last->cpu_t) / max((uint64_t)1, cpu_ticks)) / 10.0, 0.0, 100.0 * Shared::coreCount);
+			}
+			close(task_fd);
+			rng::sort(tasks, rng::less{}, &proc_info::pid);
+			cache.tasks = std::move(tasks);
+			cache.threads = proc.threads;
+			cache.cpu_t = proc.cpu_t;
+		}
+		else {
+			for (auto& task : cache.tasks) task.cpu_p = 0.0;
+		}
+
+		for (auto& task : cache.tasks) {
+			task.cpu_c = (double)task.cpu_t / max(1.0, (uptime * Shared::clkTck) - task.cpu_s);
+			task.ppid = (task.pid == proc.pid ? proc.ppid : proc.pid);
+			task.threads = 1;
+			task.mem = proc.mem;
+			task.user = proc.user;
+			task.cmd = proc.cmd;
+			task.short_cmd = proc.short_cmd;
+		}
+	}
+
+	//* Values read from /proc/[pid]/* by scan_pids(), applied to current_procs when the batches are merged
+	struct proc_sample {
+		size_t pid{};
+		stat_fields stat;
+		uint64_t mem{};
+		uint64_t run_ns{}, wait_ns{};	//? Time on cpu and waiting on a run queue from schedstat
+		bool sched{};	//? True if schedstat was read
+		uint64_t io_read{}, io_write{};	//? Bytes read from and written to storage from io
+		bool io{};		//? True if io was read
+		bool fresh{};	//? True if pid is new or reused by a new process
+		bool info{};	//? True if the name was read and cmd and user need to be read again, set for fresh pids and pids that called exec since last update
+		string name;
+	};
+
+	//* Parse read_bytes and write_bytes from the "<field>: <value>" lines of /proc/[pid]/io
+	static bool parse_io(std::string_view text, uint64_t& read, uint64_t& write) {
+		int found{};
+		for (const auto line : text | std::views::split('\n')) {
+			const std::string_view entry{line.begin(), line.end()};
+			if (entry.starts_with("read_bytes: "))
+				found += std::from_chars(entry.data() + 12, entry.data() + entry.size(), read).ec == std::errc();
+			else if (entry.starts_with("write_bytes: "))
+				found += std::from_chars(entry.data() + 13, entry.data() + entry.size(), write).ec == std::errc();
+		}
+		return found == 2;
+	}
+
+	//* Read stat, statm, schedstat if <schedstat> is set and io if <io> is set for <pids> into <batch>, pids that disappeared since they were listed are skipped
+	//* Only reads pid_index, exec_pids and current_procs, which are not modified while a scan is running
+	static void scan_pids(std::span<const size_t> pids, vector<proc_sample>& batch, bool pause_proc_list, uint64_t totalMem, bool schedstat, bool io, [[maybe_unused]] bool use_uring) {
+		array<char, 64> path_buf;
+		array<char, 1024> stat_buf;
+		stat_fields stat;
+
+	#if defined(IORING_SETUP_SUBMIT_ALL)
+		//? Each scan thread has its own ring, the stat files of batch_size pids at a time are read with a single syscall
+		constexpr size_t chunk_size = uring_reader::batch_size;
+		thread_local uring_reader uring;
+		thread_local vector<char> stat_bufs;
+		array<int, chunk_size> stat_sizes;
+		if (use_uring and not uring.active() and not uring_failed) {
+			if (uring.start()) stat_bufs.resize(chunk_size * stat_buf.size());
+			else if (not uring_failed.exchange(true))
+				Logger::warning("Proc: io_uring unavailable ({}), reading /proc synchronously", strerror(errno));
+		}
+		bool batched = false;
+	#endif
+
+		for (size_t i = 0; i < pids.size(); i++) {
+			const auto pid = pids[i];
+			if (Runner::stopping) return;
+
+		#if defined(IORING_SETUP_SUBMIT_ALL)
+			if (i % chunk_size == 0) {
+				batched = use_uring and uring.active() and not uring_failed
+					and uring.read(pids.subspan(i, min(chunk_size, pids.size() - i)), "stat", stat_bufs, stat_buf.size(), stat_sizes);
+				if (use_uring and uring.active() and not batched and not uring_failed.exchange(true))
+					Logger::warning("Proc: io_uring read failed ({}), reading /proc synchronously", strerror(errno));
+			}
+			const auto stat_data = batched
+				? std::string_view{stat_bufs.data() + (i % chunk_size) * stat_buf.size(), static_cast<size_t>(max(0, stat_sizes[i % chunk_size]))}
+				: read_cached(stat_fds, pid, "stat", path_buf, stat_buf);
+		#else
+			const auto stat_data = read_cached(stat_fds, pid, "stat", path_buf, stat_buf);
+		#endif
+			if (not parse_stat(stat_data, stat)) continue;
+
+			//? A process is identified by both pid and start time, so a reused pid gets a fresh entry
+			//? instead of inheriting the cached name, command and user
+			const auto find_old = pid_index.find(pid);
+			const bool fresh = find_old == pid_index.end()
+							or (current_procs[find_old->second].cpu_s != 0 and current_procs[find_old->second].cpu_s != static_cast<uint64_t>(stat[22]));
+			//? Only add new processes if not paused
+			if (fresh and pause_proc_list) continue;
+
+			auto& sample = batch.emplace_back();
+			sample.pid = pid;
+			sample.stat = stat;
+			sample.stat.comm = {};
+			sample.fresh = fresh;
+			sample.info = fresh or exec_pids.contains(pid);
+
+			if (sample.info) sample.name = stat.comm;
+
+			//? RSS memory (can be inaccurate, but parsing smaps increases total cpu usage by ~20x)
+			sample.mem = (stat[24] < 0 ? totalMem : min(static_cast<uint64_t>(stat[24]) * Shared::pageSize, totalMem));
+
+			//? Get RSS memory from /proc/[pid]/statm if value from /proc/[pid]/stat looks wrong
+			if (sample.mem >= totalMem) {
+				const auto statm = read_at(proc_fd, pid_path(path_buf, pid, "statm"), stat_buf);
+				const auto rss = statm.substr(min(statm.find(' ') + 1, statm.size()));
+				uint64_t rss_pages{};
+				std::from_chars(rss.data(), rss.data() + rss.size(), rss_pages);
+				sample.mem = rss_pages * Shared::pageSize;
+			}
+
+			//? Nanosecond cpu time and run queue wait time, "<on cpu> <waiting> <timeslices>"
+			if (schedstat) {
+				const auto sched = read_cached(schedstat_fds, pid, "schedstat", path_buf, stat_buf);
+				const auto end = sched.data() + sched.size();
+				if (auto [ptr, ec] = std::from_chars(sched.data(), end, sample.run_ns); ec == std::errc() and ptr != end)
+					sample.sched = std::from_chars(ptr + 1, end, sample.wait_ns).ec == std::errc();
+			}
+
+			//? Storage io counters, reading io of processes of other users fails with EACCES unless running as root
+			if (io) sample.io = parse_io(read_cached(io_fds, pid, "io", path_buf, stat_buf), sample.io_read, sample.io_write);
+		}
+	}
+
+	//* Persistent pool of threads used to scan /proc in parallel when proc_workers is set higher than 1
+	//* The calling thread takes part in every job, so a pool of n workers keeps n - 1 threads waiting for work
+	class scan_pool {
+		vector<join_thread> threads;
+		std::mutex mtx;
+		std::condition_variable work_cv;
+		std::condition_variable done_cv;
+		std::function<void()> job;
+		uint64_t generation{};
+		size_t running{};
+		bool quit{};
+
+		void worker(uint64_t seen) {
+			std::unique_lock lock(mtx);
+			while (true) {
+				work_cv.wait(lock, [&]{ return quit or generation != seen; });
+				if (quit) return;
+				seen = generation;
+				lock.unlock();
+				job();
+				lock.lock();
+				if (--running == 0) done_cv.notify_one();
+			}
+		}
+
+		void stop() {
+			{
+				std::lock_guard lock(mtx);
+				quit = true;
+			}
+			work_cv.notify_all();
+			threads.clear();
+			quit = false;
+		}
+
+	public:
+		~scan_pool() { stop(); }
+
+		size_t size() const { return threads.size() + 1; }
+
+		//* Start or stop threads so that <workers> threads including the caller take part in each job
+		void resize(size_t workers) {
+			workers = max((size_t)1, workers);
+			if (workers == size()) return;
+			stop();
+			for (size_t i = 1; i < workers; i++) {
+				threads.emplace_back(&scan_pool::worker, this, generation);
+			}
+		}
+
+		//* Run <func> on every worker and the calling thread, returns when all of them have finished
+		void run(const std::function<void()>& func) {
+			if (threads.empty()) {
+				func();
+				return;
+			}
+			{
+				std::lock_guard lock(mtx);
+				job = func;
+				running = threads.size();
+				generation++;
+			}
+			work_cv.notify_all();
+			func();
+			std::unique_lock lock(mtx);
+			done_cv.wait(lock, [&]{ return running == 0; });
+		}
+	};
+
+	//* Listener for fork, exec and exit events from the kernel proc connector (requires root or CAP_NET_ADMIN)
+	//* Keeps the set of live pids up to date between full scans of /proc and counts every exited process,
+	//* including processes that lived shorter than update_ms and were never seen by a scan
+	class proc_connector {
+		int sock = -1;
+		join_thread listener;
+		atomic<bool> quit{};
+		std::mutex mtx;
+		std::unordered_set<size_t> live;
+		std::unordered_set<size_t> execed;
+		vector<pair<size_t, bool>> journal;	//? Forks (true) and exits (false) received while a full scan is running
+		bool journaling{};
+		bool lost = true;
+		atomic<bool> failed{};
+		size_t exited{};
+
+		bool send_op(proc_cn_mcast_op op) {
+			alignas(nlmsghdr) array<char, NLMSG_SPACE(sizeof(cn_msg) + sizeof(proc_cn_mcast_op))> buf{};
+			auto* hdr = reinterpret_cast<nlmsghdr*>(buf.data());
+			hdr->nlmsg_len = NLMSG_LENGTH(sizeof(cn_msg) + sizeof(proc_cn_mcast_op));
+			hdr->nlmsg_type = NLMSG_DONE;
+			auto* msg = static_cast<cn_msg*>(NLMSG_DATA(hdr));
+			msg->id.idx = CN_IDX_PROC;
+			msg->id.val = CN_VAL_PROC;
+			msg->len = sizeof(proc_cn_mcast_op);
+			std::memcpy(msg->data, &op, sizeof(op));
+			return send(sock, buf.data(), hdr->nlmsg_len, 0) == static_cast<ssize_t>(hdr->nlmsg_len);
+		}
+
+		//* Receive one datagram and call <handler> for every proc event in it, returns false on errors other than interrupts and timeouts
+		template<typename F>
+		bool receive(int timeout_ms, F&& handler) {
+			alignas(nlmsghdr) array<char, 8192> buf;
+			pollfd pfd{sock, POLLIN, 0};
+			if (const int ready = poll(&pfd, 1, timeout_ms); ready <= 0) return ready == 0 or errno == EINTR;
+			int len = recv(sock, buf.data(), buf.size(), MSG_DONTWAIT);
+			if (len < 0) {
+				if (errno == ENOBUFS) {
+					std::lock_guard lock(mtx);
+					lost = true;
+				}
+				return errno == ENOBUFS or errno == EINTR or errno == EAGAIN;
+			}
+			for (auto* hdr = reinterpret_cast<nlmsghdr*>(buf.data()); NLMSG_OK(hdr, len); hdr = NLMSG_NEXT(hdr, len)) {
+				if (hdr->nlmsg_type == NLMSG_ERROR or hdr->nlmsg_type == NLMSG_NOOP) continue;
+				const auto* msg = static_cast<const cn_msg*>(NLMSG_DATA(hdr));
+				if (msg->id.idx != CN_IDX_PROC or msg->id.val != CN_VAL_PROC) continue;
+				handler(*reinterpret_cast<const proc_event*>(msg->data));
+			}
+			return true;
+		}
+
+		void listen() {
+			while (not quit) {
+				const bool ok = receive(500, [&](const proc_event& ev) {
+					std::lock_guard lock(mtx);
+					switch (ev.what) {
+					case proc_event::PROC_EVENT_FORK:
+						//? Only count new processes, not new threads
+						if (ev.event_data.fork.child_pid != ev.event_data.fork.child_tgid) break;
+						live.insert(ev.event_data.fork.child_tgid);
+						if (journaling) journal.emplace_back(ev.event_data.fork.child_tgid, true);
+						break;
+					case proc_event::PROC_EVENT_EXEC:
+						execed.insert(ev.event_data.exec.process_tgid);
+						break;
+					case proc_event::PROC_EVENT_EXIT:
+						if (ev.event_data.exit.process_pid != ev.event_data.exit.process_tgid) break;
+						live.erase(ev.event_data.exit.process_tgid);
+						if (journaling) journal.emplace_back(ev.event_data.exit.process_tgid, false);
+						exited++;
+						break;
+					default:
+						break;
+					}
+				});
+				if (not ok) {
+					Logger::error("Proc connector: receive failed ({}), falling back to scanning /proc", strerror(errno));
+					std::lock_guard lock(mtx);
+					lost = true;
+					failed = true;
+					active = false;
+					return;
+				}
+			}
+		}
+
+	public:
+		atomic<bool> active{};
+
+		~proc_connector() { stop(); }
+
+		//* Subscribe to proc events and start the listener thread, returns true if events are being received
+		bool start() {
+			if (active) return true;
+			if (failed) return false;
+			failed = true;
+			sock = socket(PF_NETLINK, SOCK_DGRAM | SOCK_CLOEXEC, NETLINK_CONNECTOR);
+			if (sock < 0) {
+				Logger::warning("Proc connector: could not open netlink socket ({})", strerror(errno));
+				return false;
+			}
+			sockaddr_nl addr{};
+			addr.nl_family = AF_NETLINK;
+			addr.nl_groups = CN_IDX_PROC;
+			bool acked{};
+			int ack_err = ETIMEDOUT;
+			//? The kernel reports missing privileges in the acknowledgement instead of failing the subscription message
+			if (bind(sock, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) == 0 and send_op(PROC_CN_MCAST_LISTEN)) {
+				for (int i = 0; i < 10 and not acked; i++) {
+					receive(100, [&](const proc_event& ev) {
+						if (ev.what == proc_event::PROC_EVENT_NONE) {
+							acked = true;
+							ack_err = ev.event_data.ack.err;
+						}
+					});
+				}
+			}
+			else ack_err = errno;
+			if (not acked or ack_err != 0) {
+				Logger::warning("Proc connector: could not subscribe to process events ({}), falling back to scanning /proc", strerror(ack_err));
+				close(sock);
+				sock = -1;
+				return false;
+			}
+			const int rcvbuf = 4 << 20;
+			setsockopt(sock, SOL_SOCKET, SO_RCVBUF, &rcvbuf, sizeof(rcvbuf));
+			failed = false;
+			lost = true;
+			quit = false;
+			active = true;
+			listener = join_thread(&proc_connector::listen, this);
+			return true;
+		}
+
+		//* Stop the listener thread and unsubscribe from proc events
+		void stop() {
+			quit = true;
+			listener = join_thread();
+			if (sock >= 0) {
+				send_op(PROC_CN_MCAST_IGNORE);
+				close(sock);
+				sock = -1;
+			}
+			std::lock_guard lock(mtx);
+			live.clear();
+			execed.clear();
+			journal.clear();
+			journaling = false;
+			failed = false;
+			lost = true;
+			exited = 0;
+			active = false;
+		}
+
+		//* True if events might have been dropped and the pid set needs to be rebuilt from a full scan
+		bool needs_rescan() {
+			std::lock_guard lock(mtx);
+			return lost;
+		}
+
+		//* Start recording forks and exits that happen while /proc is being scanned
+		void begin_rescan() {
+			std::lock_guard lock(mtx);
+			journal.clear();
+			journaling = true;
+			lost = false;
+		}
+
+		//* Replace the set of live pids with the scanned <pids> and the forks and exits recorded since begin_rescan()
+		void end_rescan(const vector<size_t>& pids) {
+			std::lock_guard lock(mtx);
+			live.clear();
+			live.insert(pids.begin(), pids.end());
+			for (const auto& [pid, forked] : journal) {
+				if (forked) live.insert(pid);
+				else live.erase(pid);
+			}
+			journal.clear();
+			journaling = false;
+		}
+
+		//* Copy the live pids into <pids> in ascending order
+		void get_pids(vector<size_t>& pids) {
+			{
+				std::lock_guard lock(mtx);
+				pids.assign(live.begin(), live.end());
+			}
+			rng::sort(pids);
+		}
+
+		//* Move pids that called exec since last call into <pids> and return the number of processes that exited since last call
+		size_t take_events(std::unordered_set<size_t>& pids) {
+			std::lock_guard lock(mtx);
+			pids.swap(execed);
+			execed.clear();
+			return std::exchange(exited, 0);
+		}
+	};
+
+	//* Cache of user names for the uids read from /proc/[pid]/status, filled from /etc/passwd when it changes
+	//* Uids missing from /etc/passwd are looked up with getpwuid_r() on a background thread, since NSS lookups (LDAP, SSSD)
+	//* can block for a long time, the numeric uid is shown until the name is resolved
+	class uid_resolver {
+		struct entry {
+			shared_string name;
+			uint64_t retry_after{};	//? Time in ms after which a failed lookup is tried again
+			bool resolved{};
+			bool pending{};
+		};
+		std::unordered_map<string, entry> cache;
+		//? Shared with the lookup thread, which is detached so that exit never waits on a lookup that blocks in NSS
+		struct state {
+			std::mutex mtx;
+			std::condition_variable work_cv;
+			vector<string> queue;
+			vector<pair<string, string>> results;	//? Uids and their names, with an empty name if the lookup failed
+			bool running{}, quit{};
+		};
+		std::shared_ptr<state> st = std::make_shared<state>();
+
+		static void work(std::shared_ptr<state> st) {
+			std::unique_lock lock(st->mtx);
+			while (true) {
+				st->work_cv.wait(lock, [&]{ return st->quit or not st->queue.empty(); });
+				if (st->quit) return;
+				string uid = std::move(st->queue.back());
+				st->queue.pop_back();
+				lock.unlock();
+				string name = lookup(uid);
+				lock.lock();
+				st->results.emplace_back(std::move(uid), std::move(name));
+			}
+		}
+
+		static string lookup([[maybe_unused]] const string& uid) {
+		#if !(defined(STATIC_BUILD) && defined(__GLIBC__))
+			uid_t uid_num;
+			if (auto [ptr, ec] = std::from_chars(uid.data(), uid.data() + uid.size(), uid_num); ec != std::errc()) return {};
+			struct passwd pwd;
+			struct passwd* result = nullptr;
+			vector<char> buf(1024);
+			int err;
+			while ((err = getpwuid_r(uid_num, &pwd, buf.data(), buf.size(), &result)) == ERANGE and buf.size() < 1 << 20)
+				buf.resize(buf.size() * 2);
+			if (err == 0 and result != nullptr and pwd.pw_name != nullptr) return pwd.pw_name;
+		#endif
+			return {};
+		}
+
+	public:
+		//* Time in ms a failed lookup is remembered before the uid is looked up again
+		static constexpr uint64_t negative_ttl = 60'000;
+
+		~uid_resolver() {
+			{
+				std::lock_guard lock(st->mtx);
+				st->quit = true;
+			}
+			st->work_cv.notify_all();
+		}
+
+		//* Remove all names, uids that are being looked up are kept as pending
+		void clear() {
+			std::erase_if(cache, [](const auto& e) { return not e.second.pending; });
+		}
+
+		//* Set the name of <uid> as read from /etc/passwd
+		void add(const string& uid, const string& name) {
+			auto& e = cache[uid];
+			e.name = name;
+			e.resolved = true;
+		}
+
+		//* Returns the name of <uid>, or the uid itself while the name is being looked up or if the lookup failed
+		const shared_string& name(const string& uid) {
+			auto [found, inserted] = cache.try_emplace(uid);
+			auto& e = found->second;
+			if (inserted) e.name = uid;
+			if (e.resolved or e.pending or time_ms() < e.retry_after) return e.name;
+		#if !(defined(STATIC_BUILD) && defined(__GLIBC__))
+			e.pending = true;
+			{
+				std::lock_guard lock(st->mtx);
+				st->queue.push_back(uid);
+				if (not std::exchange(st->running, true)) std::thread(work, st).detach();
+			}
+			st->work_cv.notify_one();
+		#else
+			e.retry_after = std::numeric_limits<uint64_t>::max();
+		#endif
+			return e.name;
+		}
+
+		//* Apply finished lookups and return the uids that got a name, with their name
+		vector<pair<string, shared_string>> take_resolved() {
+			vector<pair<string, string>> done;
+			{
+				std::lock_guard lock(st->mtx);
+				done.swap(st->results);
+			}
+			vector<pair<string, shared_string>> named;
+			for (auto& [uid, name] : done) {
+				auto& e = cache[uid];
+				e.pending = false;
+				if (name.empty()) {
+					if (e.name.empty()) e.name = uid;
+					e.retry_after = time_ms() + negative_ttl;
+					continue;
+				}
+				e.name = name;
+				e.resolved = true;
+				named.emplace_back(uid, e.name);
+			}
+			return named;
+		}
+	};
+
+	static uid_resolver user_names;
+
+	//* Reads of /proc/[pid] files that need the mmap lock of the process, like cmdline and smaps, block for as long as the process
+	//* holds it, or indefinitely if it is stuck in D state on a hung mount. These reads are done by detached helper threads and are
+	//* abandoned if they don't finish within read_timeout of being started, collection then continues without the value
+	class timed_reader {
+	public:
+		static constexpr auto read_timeout = 250ms;
+		static constexpr size_t helpers = 4, max_stuck = 16;
+
+		struct request {
+			size_t pid{};
+			const char* file{};
+			size_t max_size{};
+			string data{};
+			bool done{};
+			bool timed_out{};	//? Read started but didn't finish within read_timeout, not set for reads that were skipped
+		};
+		using request_ptr = std::shared_ptr<request>;
+
+	private:
+		using clock = std::chrono::steady_clock;
+		struct job {
+			request_ptr req;
+			clock::time_point started{};
+			bool running{}, abandoned{};
+		};
+		//? Shared with the helper threads, a helper stuck in a read outlives everything else
+		struct state {
+			std::mutex mtx;
+			std::condition_variable work_cv, done_cv;
+			std::deque<std::shared_ptr<job>> queue;
+			size_t threads{}, stuck{};
+		};
+		std::shared_ptr<state> st = std::make_shared<state>();
+
+		static void read_file(request& req) {
+			array<char, 64> path_buf;
+			const int fd = openat(proc_fd, pid_path(path_buf, req.pid, req.file), O_RDONLY | O_CLOEXEC);
+			if (fd < 0) return;
+			size_t size = 0;
+			req.data.resize(min(req.max_size, (size_t)4096));
+			long long syscalls = 2;
+			while (size < req.max_size) {
+				if (size == req.data.size()) req.data.resize(min(req.max_size, size * 2));
+				const auto bytes = ::read(fd, req.data.data() + size, req.data.size() - size);
+				syscalls++;
+				if (bytes <= 0) break;
+				size += bytes;
+			}
+			close(fd);
+			read_syscalls += syscalls;
+			req.data.resize(size);
+		}
+
+		static void helper(std::shared_ptr<state> st) {
+			std::unique_lock lock(st->mtx);
+			while (true) {
+				st->work_cv.wait(lock, [&] { return not st->queue.empty(); });
+				auto current = std::move(st->queue.front());
+				st->queue.pop_front();
+				if (current->abandoned) continue;
+				current->started = clock::now();
+				current->running = true;
+				lock.unlock();
+				request result{.pid = current->req->pid, .file = current->req->file, .max_size = current->req->max_size};
+				read_file(result);
+				lock.lock();
+				//? The caller stopped waiting for this read and started a replacement helper
+				if (current->abandoned) st->stuck--;
+				else {
+					current->req->data = std::move(result.data);
+					current->req->done = true;
+				}
+				current->running = false;
+				st->done_cv.notify_all();
+			}
+		}
+
+	public:
+		//* Read all <requests> on the helper threads, requests that are not done afterwards either timed out or weren't read
+		//* because too many helpers are stuck, only the first are marked timed_out
+		void read(std::span<const request_ptr> requests) {
+			std::unique_lock lock(st->mtx);
+			if (st->stuck >= max_stuck) return;
+			while (st->threads - st->stuck < helpers) {
+				std::thread(helper, st).detach();
+				st->threads++;
+			}
+			vector<std::shared_ptr<job>> jobs;
+			jobs.reserve(requests.size());
+			for (const auto& req : requests) {
+				jobs.push_back(std::make_shared<job>(job{.req = req}));
+				st->queue.push_back(jobs.back());
+			}
+			st->work_cv.notify_all();
+
+			for (const auto& current : jobs) {
+				while (not current->req->done and not current->abandoned) {
+					if (not current->running) {
+						if (st->stuck >= max_stuck) break;
+						st->done_cv.wait_for(lock, read_timeout);
+					}
+					else if (st->done_cv.wait_until(lock, current->started + read_timeout) == std::cv_status::timeout
+						and current->running and not current->req->done) {
+						//? Leave the helper behind and start a replacement for it
+						current->abandoned = true;
+						current->req->timed_out = true;
+						st->stuck++;
+						if (st->stuck < max_stuck) {
+							std::thread(helper, st).detach();
+							st->threads++;
+						}
+					}
+				}
+			}
+			//? Requests still queued when too many helpers got stuck are dropped
+			for (const auto& current : jobs) {
+				if (not current->running and not current->req->done) current->abandoned = true;
+			}
+		}
+	};
+
+	static timed_reader blocking_reads;
+
+	//* Pids whose reads timed out and when, their cmdline and smaps aren't read again until the quarantine expires
+	static std::unordered_map<size_t, std::chrono::steady_clock::time_point> quarantine;
+	constexpr auto quarantine_time = 60s;
+
+	static bool quarantined(size_t pid) {
+		const auto entry = quarantine.find(pid);
+		if (entry == quarantine.end()) return false;
+		if (std::chrono::steady_clock::now() - entry->second < quarantine_time) return true;
+		quarantine.erase(entry);
+		return false;
+	}
+
+	//* Proportional, unique and swapped memory of a process in bytes from /proc/[pid]/smaps_rollup
+	struct rollup_values {
+		uint64_t start{};	//? Start time of the process, values sampled for a pid that was reused are not applied
+		uint64_t pss{}, uss{}, swap{};
+	};
+
+	//* Parse Pss, Private_Clean, Private_Dirty and Swap from the "<field>: <value> kB" lines of smaps_rollup
+	static bool parse_rollup(std::string_view data, rollup_values& out) {
+		uint64_t clean{}, dirty{};
+		int found{};
+		for (const auto line : data | std::views::split('\n')) {
+			const std::string_view entry{line.begin(), line.end()};
+			const auto colon = entry.find(':');
+			if (colon == std::string_view::npos) continue;
+			const auto key = entry.substr(0, colon);
+			uint64_t* const target = (key == "Pss" ? &out.pss : key == "Private_Clean" ? &clean : key == "Private_Dirty" ? &dirty : key == "Swap" ? &out.swap : nullptr);
+			const auto value = entry.find_first_not_of(' ', colon + 1);
+			if (target != nullptr and value != std::string_view::npos)
+				found += std::from_chars(entry.data() + value, entry.data() + entry.size(), *target).ec == std::errc();
+		}
+		out.pss <<= 10;
+		out.swap <<= 10;
+		out.uss = (clean + dirty) << 10;
+		return found == 4;
+	}
+
+	//* Reads smaps_rollup of all processes round-robin on a background thread with the lowest nice value. Each update hands it the
+	//* live processes and it reads as many as fit in the time budget, continuing after the last pid it read. smaps_rollup walks every
+	//* mapping of a process under its mmap lock, so reading it for all processes within the update itself would be far too slow
+	class rollup_sampler {
+		using clock = std::chrono::steady_clock;
+		//? Shared with the sampler thread, a thread stuck in a read is left behind with its own state
+		struct state {
+			std::mutex mtx;
+			std::condition_variable work_cv;
+			vector<pair<size_t, uint64_t>> procs;	//? Pid and start time of the processes to read, sorted by pid
+			std::unordered_map<size_t, rollup_values> values;
+			clock::duration budget{};
+			size_t next_pid{};		//? The first pid at or above this is read next
+			uint64_t generation{};
+			bool busy{};
+			atomic<size_t> reading{};		//? Pid being read, 0 between reads and abandoned_read once the thread is left behind
+			atomic<clock::rep> read_started{};
+			std::shared_ptr<atomic<size_t>> stuck;	//? Threads left behind in a read, counted down again when their read returns
+		};
+		static constexpr size_t abandoned_read = std::numeric_limits<size_t>::max();
+		std::shared_ptr<state> st;
+		std::shared_ptr<atomic<size_t>> stuck = std::make_shared<atomic<size_t>>(0);
+
+		static void worker(std::shared_ptr<state> st) {
+			setpriority(PRIO_PROCESS, static_cast<id_t>(syscall(SYS_gettid)), 19);
+			vector<pair<size_t, uint64_t>> procs;
+			vector<rollup_values> results;
+			vector<size_t> result_pids;
+			array<char, 64> path_buf;
+			array<char, 4096> buf;
+			uint64_t seen{};
+			std::unique_lock lock(st->mtx);
+			while (true) {
+				st->work_cv.wait(lock, [&] { return st->generation != seen; });
+				seen = st->generation;
+				procs.swap(st->procs);
+				const auto deadline = clock::now() + st->budget;
+				size_t next_pid = st->next_pid;
+				st->busy = true;
+				lock.unlock();
+
+				results.clear();
+				result_pids.clear();
+				auto it = rng::lower_bound(procs, next_pid, rng::less{}, &pair<size_t, uint64_t>::first);
+				for (size_t n = 0; n < procs.size() and clock::now() < deadline; n++, ++it) {
+					if (it == procs.end()) it = procs.begin();
+					const auto [pid, start] = *it;
+					next_pid = pid + 1;
+					st->read_started = clock::now().time_since_epoch().count();
+					st->reading = pid;
+					const int fd = openat(proc_fd, pid_path(path_buf, pid, "smaps_rollup"), O_RDONLY | O_CLOEXEC);
+					ssize_t len = -1;
+					if (fd >= 0) {
+						len = read(fd, buf.data(), buf.size());
+						close(fd);
+					}
+					if (st->reading.exchange(0) == abandoned_read) {
+						st->stuck->fetch_sub(1);
+						return;
+					}
+					rollup_values values{.start = start};
+					if (len > 0 and parse_rollup({buf.data(), static_cast<size_t>(len)}, values)) {
+						results.push_back(values);
+						result_pids.push_back(pid);
+					}
+				}
+
+				lock.lock();
+				for (size_t i = 0; i < results.size(); i++) st->values[result_pids[i]] = results[i];
+				st->next_pid = next_pid;
+				st->busy = false;
+			}
+		}
+
+	public:
+		//* Queue the processes in <procs> for sampling with <budget> of reading time, skipped while the previous round is still running.
+		//* A read that blocks for longer than timed_reader::read_timeout quarantines its pid and sampling restarts on a new thread,
+		//* sampling pauses while too many threads are stuck and resumes as their reads return
+		void update(const vector<proc_info>& procs, std::chrono::milliseconds budget) {
+			if (size_t pid = st ? st->reading.load() : 0; pid != 0 and *stuck < timed_reader::max_stuck
+			and clock::now() - clock::time_point{clock::duration{st->read_started.load()}} > budget + timed_reader::read_timeout) {
+				//? Counted before the thread is left behind, since the read can return and count down right after
+				const auto count = stuck->fetch_add(1) + 1;
+				if (st->reading.compare_exchange_strong(pid, abandoned_read)) {
+					quarantine[pid] = std::chrono::steady_clock::now();
+					st.reset();
+					if (count == timed_reader::max_stuck) Logger::warning("Proc: too many blocked smaps_rollup reads, pss sampling paused until they return");
+				}
+				else stuck->fetch_sub(1);
+			}
+			if (*stuck >= timed_reader::max_stuck) return;
+			if (not st) {
+				st = std::make_shared<state>();
+				st->stuck = stuck;
+				std::thread(worker, st).detach();
+			}
+			std::lock_guard lock(st->mtx);
+			if (st->busy) return;
+			st->procs.clear();
+			for (const auto& p : procs) {
+				if (p.state != 'X' and not quarantine.contains(p.pid)) st->procs.emplace_back(p.pid, p.cpu_s);
+			}
+			rng::sort(st->procs);
+			std::erase_if(st->values, [&](const auto& entry) {
+				return not rng::binary_search(st->procs, std::make_pair(entry.first, entry.second.start));
+			});
+			st->budget = budget;
+			st->generation++;
+			st->work_cv.notify_one();
+		}
+
+		//* Copy the last sampled values to <procs>, processes that weren't read yet are set to 0
+		void apply(vector<proc_info>& procs) {
+			if (not st) return;
+			std::lock_guard lock(st->mtx);
+			for (auto& p : procs) {
+				const auto values = st->values.find(p.pid);
+				const bool valid = values != st->values.end() and values->second.start == p.cpu_s;
+				p.pss = valid ? values->second.pss : 0;
+				p.uss = valid ? values->second.uss : 0;
+				p.swap = valid ? values->second.swap : 0;
+				p.rollup_sampled = valid;
+			}
+		}
+
+		//* Forget the sampled values when sampling is turned off, the thread waits for the next update
+		void clear() {
+			if (not st) return;
+			std::lock_guard lock(st->mtx);
+			st->values.clear();
+		}
+	};
+
+	static rollup_sampler rollup_samples;
+
+	//* Pids whose command line and user haven't been read since the process started or called exec, most processes are never shown
+	//* so these are only read by materialize() for rows that are visible, the detailed view and filters or sorting that need them
+	static std::unordered_set<size_t> pending_info;
+
+	//* Read command line and user of the pending processes in <pids> from /proc/[pid]/cmdline and /proc/[pid]/status,
+	//* processes that can't be read in time are quarantined and marked unreadable, keeping their last values
+	static void fetch_info(std::span<const size_t> pids) {
+		static vector<timed_reader::request_ptr> requests;
+		requests.clear();
+		for (const auto pid : pids) {
+			if (not pending_info.contains(pid) or not pid_index.contains(pid)) continue;
+			if (quarantined(pid)) {
+				current_procs[pid_index.at(pid)].unreadable = true;
+				continue;
+			}
+			requests.push_back(std::make_shared<timed_reader::request>(timed_reader::request{.pid = pid, .file = "cmdline", .max_size = 1000}));
+			requests.push_back(std::make_shared<timed_reader::request>(timed_reader::request{.pid = pid, .file = "status", .max_size = 2048}));
+		}
+		if (requests.empty()) return;
+		blocking_reads.read(requests);
+
+		for (size_t i = 0; i + 1 < requests.size(); i += 2) {
+			const auto& cmdline = *requests[i];
+			const auto& status = *requests[i + 1];
+			const auto index = pid_index.find(cmdline.pid);
+			if (index == pid_index.end()) continue;
+			auto& proc = current_procs[index->second];
+			if (cmdline.timed_out or status.timed_out) {
+				quarantine[cmdline.pid] = std::chrono::steady_clock::now();
+				proc.unreadable = true;
+				continue;
+			}
+			//? Skipped because too many helpers are stuck, stays pending and is tried again on a later update
+			if (not cmdline.done or not status.done) continue;
+			std::string_view cmd_view = cmdline.data;
+			while (cmd_view.ends_with('\0')) cmd_view.remove_suffix(1);
+			string cmd{cmd_view};
+			rng::replace(cmd, '\0', ' ');
+			proc.cmd = std::move(cmd);
+
+			const std::string_view status_view = status.data;
+			if (auto uid_pos = status_view.find("\nUid:\t"); uid_pos != std::string_view::npos) {
+				const auto uid_field = status_view.substr(uid_pos + 6);
+				proc.user = user_names.name(string{uid_field.substr(0, uid_field.find_first_of("\t\n"))});
+			}
+			proc.short_cmd = shared_string{};
+			proc.unreadable = false;
+			pending_info.erase(cmdline.pid);
+		}
+	}
+
+	//* Make sure cmd and user of process <pid> are read, returns nullptr if <pid> isn't a known process
+	static proc_info* materialize(size_t pid) {
+		const auto index = pid_index.find(pid);
+		if (index == pid_index.end()) return nullptr;
+		if (pending_info.contains(pid)) fetch_info({&pid, 1});
+		return &current_procs[index->second];
+	}
+
+	//* Make sure cmd and user of <row> are read, rows of threads get them from their process
+	static void materialize(proc_info& row) {
+		const auto proc = pid_index.contains(row.pid) ? materialize(row.pid) : materialize(row.ppid);
+		if (proc != nullptr and proc != &row) {
+			row.cmd = proc->cmd;
+			row.user = proc->user;
+			row.unreadable = proc->unreadable;
+		}
+	}
+
+	//* Make sure cmd and user of <rows> and of the processes <pids> are read, with a single batch of reads for all of them
+	static void materialize(const vector<proc_info*>& rows, std::initializer_list<size_t> pids) {
+		static vector<size_t> pending;
+		pending.clear();
+		for (const auto row : rows) {
+			const auto pid = pid_index.contains(row->pid) ? row->pid : row->ppid;
+			if (pending_info.contains(pid)) pending.push_back(pid);
+		}
+		for (const auto pid : pids) {
+			if (pending_info.contains(pid)) pending.push_back(pid);
+		}
+		if (not pending.empty()) {
+			//? Thread rows of the same process share its pid
+			rng::sort(pending);
+			pending.erase(std::unique(pending.begin(), pending.end()), pending.end());
+			fetch_info(pending);
+		}
+		for (const auto row : rows) materialize(*row);
+	}
+
+	//* Read cmd and user of all pending processes and update <rows> if they are thread rows
+	static void materialize_all(vector<proc_info>& rows) {
+		if (not pending_info.empty()) {
+			const vector<size_t> pids(pending_info.begin(), pending_info.end());
+			fetch_info(pids);
+		}
+		if (&rows != &current_procs) {
+			for (auto& row : rows) materialize(row);
+		}
+	}
+
+	//* Get detailed info for selected process
+	static void _collect_details(const size_t pid, const uint64_t uptime, vector<proc_info>& procs) {
+		fs::path pid_path = Shared::procPath / std::to_string(pid);
+
+		if (pid != detailed.last_pid) {
+			detailed = {};
+			detailed.last_pid = pid;
+			detailed.skip_smaps = not Config::getB("proc_info_smaps");
+			//? Start the graphs from the recorded history of the process
+			history.cpu(pid, detailed.cpu_percent);
+			history.mem(pid, detailed.mem_bytes);
+		}
+
+		//? Copy proc_info for process from proc vector
+		auto p_info = rng::find(procs, pid, &proc_info::pid);
+		detailed.entry = *p_info;
+		//? Stays marked while reads of the process are quarantined, the row itself is only marked when its cmdline read times out
+		if (quarantined(pid)) detailed.entry.unreadable = true;
+
+		//? Update cpu percent deque for process cpu graph
+		if (not Config::getB("proc_per_core")) detailed.entry.cpu_p *= Shared::coreCount;
+		detailed.cpu_percent.push_back(clamp((long long)round(detailed.entry.cpu_p), 0ll, 100ll));
+		while (cmp_greater(detailed.cpu_percent.size(), width)) detailed.cpu_percent.pop_front();
+
+		//? Process runtime
+		if (detailed.entry.state != 'X') detailed.elapsed = sec_to_dhms(uptime - (detailed.entry.cpu_s / Shared::clkTck));
+		else detailed.elapsed = sec_to_dhms(detailed.entry.death_time);
+		if (detailed.elapsed.size() > 8) detailed.elapsed.resize(detailed.elapsed.size() - 3);
+
+		//? Get parent process name
+		if (detailed.parent.empty()) {
+			auto p_entry = rng::find(procs, detailed.entry.ppid, &proc_info::pid);
+			if (p_entry != procs.end()) detailed.parent = p_entry->name;
+		}
+
+		//? Expand process status from single char to explanative string
+		detailed.status = (proc_states.contains(detailed.entry.state)) ? proc_states.at(detailed.entry.state) : "Unknown";
+
+		ifstream d_read;
+		string short_str;
+
+		//? Try to get RSS mem from proc/[pid]/smaps_rollup, or smaps on kernels before 4.14 that don't have the rollup,
+		//? read by a helper thread since it blocks while the process holds its mmap lock
+		detailed.memory.clear();
+		if (not detailed.skip_smaps and not quarantined(pid)) {
+			static const bool has_rollup = faccessat(proc_fd, "self/smaps_rollup", R_OK, 0) == 0;
+			const auto smaps = std::make_shared<timed_reader::request>(has_rollup
+				? timed_reader::request{.pid = pid, .file = "smaps_rollup", .max_size = 4096}
+				: timed_reader::request{.pid = pid, .file = "smaps", .max_size = 64 << 20});
+			blocking_reads.read({&smaps, 1});
+			if (smaps->timed_out) {
+				quarantine[pid] = std::chrono::steady_clock::now();
+				detailed.entry.unreadable = true;
+			}
+			else if (not smaps->data.empty()) {
+				const std::string_view data = smaps->data;
+				uint64_t rss = 0;
+				for (size_t pos = 0; (pos = data.find("\nRss:", pos)) != std::string_view::npos;) {
+					pos = data.find_first_not_of(' ', pos + 5);
+					if (pos == std::string_view::npos) break;
+					uint64_t value{};
+					std::from_chars(data.data() + pos, data.data() + data.size(), value);
+					rss += value;
+				}
+				if (rss == detailed.entry.mem >> 10)
+					detailed.skip_smaps = true;
+				else {
+					detailed.mem_bytes.push_back(rss << 10);
+					detailed.memory = floating_humanizer(rss, false, 1);
+				}
+			}
+		}
+		if (detailed.memory.empty()) {
+			detailed.mem_bytes.push_back(detailed.entry.mem);
+			detailed.memory = floating_humanizer(detailed.entry.mem);
+		}
+		if (detailed.first_mem == -1 or detailed.first_mem < detailed.mem_bytes.back() / 2 or detailed.first_mem > detailed.mem_bytes.back() * 4) {
+			detailed.first_mem = min((uint64_t)detailed.mem_bytes.back() * 2, Mem::get_totalMem());
+			redraw = true;
+		}
+
+		while (cmp_greater(detailed.mem_bytes.size(), width)) detailed.mem_bytes.pop_front();
+
+		//? Get bytes read and written from proc/[pid]/io
+		if (fs::exists(pid_path / "io")) {
+			d_read.open(pid_path / "io");
+			try {
+				string name;
+				while (d_read.good()) {
+					getline(d_read, name, ':');
+					if (name.ends_with("read_bytes")) {
+						getline(d_read, short_str);
+						detailed.io_read = floating_humanizer(stoull(short_str));
+					}
+					else if (name.ends_with("write_bytes")) {
+						getline(d_read, short_str);
+						detailed.io_write = floating_humanizer(stoull(short_str));
+						break;
+					}
+					else
+						d_read.ignore(SSmax, '\n');
+				}
+			}
+			catch (const std::invalid_argument&) {}
+			catch (const std::out_of_range&) {}
+			d_read.close();
+		}
+	}
+
+	//* Collects and sorts process information from /proc
+	auto collect(bool no_update) -> vector<proc_info>& {
+		if (Runner::stopping) return current_procs;
+		const auto& sorting = Config::getS("proc_sorting");
+		auto reverse = Config::getB("proc_reversed");
+		const auto& filter = Config::getS("proc_filter");
+		auto per_core = Config::getB("proc_per_core");
+		auto should_filter_kernel = Config::getB("proc_filter_kernel");
+		auto tree = Config::getB("proc_tree");
+		auto show_detailed = Config::getB("show_detailed");
+		const auto pause_proc_list = Config::getB("pause_proc_list");
+		size_t detailed_pid = Config::getI("detailed_pid");
+		const bool threads_mode = Config::getB("proc_threads") and not tree;
+		static bool was_threads_mode{};
+		const bool threads_mode_change = threads_mode != was_threads_mode;
+		was_threads_mode = threads_mode;
+		const bool group_mode = Config::getB("proc_group") and not tree and not threads_mode;
+		static bool was_group_mode{};
+		const bool group_mode_change = group_mode != was_group_mode;
+		was_group_mode = group_mode;
+
+		//? Threads selected in thread mode show the detailed view of their process
+		if (show_detailed and detailed_pid != 0 and not pid_index.contains(detailed_pid)) {
+			if (auto task = rng::find(thread_procs, detailed_pid, &proc_info::pid); task != thread_procs.end() and pid_index.contains(task->ppid)) {
+				detailed_pid = task->ppid;
+				Config::set("detailed_pid", static_cast<int>(detailed_pid));
+			}
+		}
+		bool should_filter = current_filter != filter;
+		if (should_filter) current_filter = filter;
+		bool sorted_change = (sorting != current_sort or reverse != current_rev or should_filter);
+		bool tree_mode_change = tree != is_tree_mode;
+		if (sorted_change) {
+			current_sort = sorting;
+			current_rev = reverse;
+		}
+		if (tree_mode_change) is_tree_mode = tree;
+		ifstream pread;
+
+		static std::unordered_set<size_t> found;
+
+		const double uptime = system_uptime();
+
+		const int cmult = (per_core) ? Shared::coreCount : 1;
+		bool got_detailed = false;
+
+		static size_t proc_clear_count{};
+
+		//* Use pids from last update if only changing filter, sorting or tree options
+		if (no_update and not current_procs.empty()) {
+			if (show_detailed and detailed_pid != detailed.last_pid) {
+				materialize(detailed_pid);
+				_collect_details(detailed_pid, round(uptime), current_procs);
+			}
+		}
+		//* ---------------------------------------------Collection start----------------------------------------------
+		else {
+			collect_counters counters;
+			should_filter = true;
+			found.clear();
+
+			//? First make sure kernel proc cache is cleared.
+			if (should_filter_kernel and ++proc_clear_count >= 256) {
+				//? Clearing the cache is used in the event of a pid wrap around.
+				//? In that event processes that acquire old kernel pids would also be filtered out so we need to manually clean the cache every now and then.
+				kernels_procs.clear();
+				kernels_procs.emplace(KTHREADD);
+				proc_clear_count = 0;
+			}
+
+			auto totalMem = Mem::get_totalMem();
+
+			//? Update uid_user map if /etc/passwd changed since last run
+			if (not Shared::passwd_path.empty() and fs::last_write_time(Shared::passwd_path) != passwd_time) {
+				string r_uid, r_user;
+				passwd_time = fs::last_write_time(Shared::passwd_path);
+				user_names.clear();
+				pread.open(Shared::passwd_path);
+				if (pread.good()) {
+					std::unordered_set<string> seen;
+					while (pread.good()) {
+						getline(pread, r_user, ':');
+						pread.ignore(SSmax, ':');
 						getline(pread, r_uid, ':');
-						if (uid_user.contains(r_uid)) break;
-						uid_user[r_uid] = r_user;
+						if (not seen.insert(r_uid).second) break;
+						user_names.add(r_uid, r_user);
 						pread.ignore(SSmax, '\n');
 					}
 				}
@@ -3279,6 +4945,15 @@ namespace Proc {
 				pread.close();
 			}
 
+			//? Replace numeric uids shown for processes whose user name was looked up since last update
+			if (const auto named = user_names.take_resolved(); not named.empty()) {
+				for (auto& p : current_procs) {
+					for (const auto& [uid, name] : named) {
+						if (p.user == uid) p.user = name;
+					}
+				}
+			}
+
 			//? Get cpu total times from /proc/stat up to the guest field
 			cputimes = 0;
 			pread.open(Shared::procPath / "stat");
@@ -3288,204 +4963,322 @@ namespace Proc {
 				for (uint64_t times; i < 8 and pread >> times; cputimes += times, i++);
 			}
 			else throw std::runtime_error("Failure to read /proc/stat");
+
+			//? System wide context switches, a jump in the rate of switches wakes the whole cold tier
+			const int cold_interval = Config::getI("proc_cold_interval");
+			bool wake_cold = true;
+			if (cold_interval > 0) {
+				static uint64_t last_ctxt{};
+				static double ctxt_rate{};
+				uint64_t ctxt{};
+				for (string line; getline(pread, line);) {
+					if (line.starts_with("ctxt ")) {
+						std::from_chars(line.data() + 5, line.data() + line.size(), ctxt);
+						break;
+					}
+				}
+				if (last_ctxt != 0 and ctxt >= last_ctxt) {
+					const double delta = ctxt - last_ctxt;
+					wake_cold = ctxt_rate == 0 or delta > 2 * ctxt_rate;
+					ctxt_rate = ctxt_rate == 0 ? delta : 0.8 * ctxt_rate + 0.2 * delta;
+				}
+				last_ctxt = ctxt;
+			}
+			else if (not tiers.empty()) {
+				tiers.clear();
+				cold_procs = -1;
+				stale_cpu = 0.0;
+			}
 			pread.close();
 
-			//? Iterate over all pids in /proc
-			for (const auto& d: fs::directory_iterator(Shared::procPath)) {
-				if (Runner::stopping)
-					return current_procs;
+			if (proc_fd < 0) {
+				proc_fd = open(Shared::procPath.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+				if (proc_fd < 0) throw std::runtime_error("Failure to open " + Shared::procPath.string());
+			}
 
-				if (pread.is_open()) pread.close();
+			//? Get all pids, either from the proc connector or from a full scan of /proc that also serves as a periodic safety net
+			//? for the connector in case events were dropped. With a scope set only the pids in the scope are listed
+			const auto& scope = current_scope();
+			static proc_connector proc_events;
+			static size_t events_count{};
+			const bool use_events = scope.empty() and Config::getB("proc_events") and proc_events.start();
+			if (not use_events and proc_events.active) proc_events.stop();
+			static bool used_events{};
+			if (use_events != used_events) {
+				used_events = use_events;
+				redraw = true;
+			}
+			static vector<size_t> pids;
+			//? Pid scope that couldn't be listed from the children files, tried again when proc_scope changes
+			static string failed_scope;
+			const auto& scope_text = Config::getS("proc_scope");
+			bool scoped = false;
+			if (not scope.empty() and (scope.pid == 0 or scope_text != failed_scope)) {
+				scoped = list_scope(scope, Shared::procPath, pids);
+				if (not scoped) {
+					failed_scope = scope_text;
+					Logger::warning("proc_scope: /proc/[pid]/task/[tid]/children isn't available, collecting all processes");
+				}
+			}
+			if (not scoped and (not use_events or proc_events.needs_rescan() or ++events_count >= 16)) {
+				events_count = 0;
+				if (use_events) proc_events.begin_rescan();
+				pids.clear();
+				static dir_scanner proc_scanner{256 << 10};
+				if (lseek(proc_fd, 0, SEEK_SET) != 0 or not proc_scanner.numeric(proc_fd, pids))
+					throw std::runtime_error("Failed to list " + Shared::procPath.string() + ": " + strerror(errno));
+				if (use_events) proc_events.end_rescan(pids);
+			}
+			else if (not scoped) proc_events.get_pids(pids);
 
-				const string pid_str = d.path().filename();
-				if (not isdigit(pid_str[0])) continue;
+			if (use_events) exited_procs = static_cast<int>(proc_events.take_events(exec_pids));
+			else {
+				exec_pids.clear();
+				exited_procs = -1;
+			}
 
-				const size_t pid = stoul(pid_str);
+			if (should_filter_kernel) {
+				std::erase_if(pids, [](size_t pid) { return kernels_procs.contains(pid); });
+			}
 
-				if (should_filter_kernel and kernels_procs.contains(pid)) {
-					continue;
+			//? Parse files for all pids, shards of pids are handed out to the scan workers and each shard is read into its own batch
+			//? The batches are merged in order afterwards, so the result is the same regardless of the number of workers
+			static scan_pool workers;
+			static vector<vector<proc_sample>> batches;
+			const auto proc_workers = Config::getI("proc_workers");
+			workers.resize(proc_workers > 0 ? proc_workers : Shared::coreCount);
+			//? The descriptor budget is split evenly between the files read for every process
+			const bool schedstat = Config::getB("proc_schedstat");
+			const bool proc_io = Config::getB("proc_io");
+			const int fd_budget = Config::getI("proc_fd_budget") / (1 + schedstat + proc_io);
+			stat_fds.set_budget(fd_budget);
+			schedstat_fds.set_budget(schedstat ? fd_budget : 0);
+			io_fds.set_budget(proc_io ? fd_budget : 0);
+
+			//? io is only read every proc_io_interval updates, rates are averaged over the time since each process was last read
+			static uint64_t io_tick{};
+			const bool read_io = proc_io and io_tick++ % Config::getI("proc_io_interval") == 0;
+			const uint64_t io_time = static_cast<uint64_t>(get_monotonicTimeUSec());
+
+			//? Schedstat times are divided by the monotonic time since the last update, values from before the mode was enabled aren't used
+			static long long last_sched_time{};
+			const long long sched_time = get_monotonicTimeUSec();
+			const double sched_window_ns = schedstat and last_sched_time > 0 ? (sched_time - last_sched_time) * 1000.0 : 0.0;
+			last_sched_time = schedstat ? sched_time : 0;
+			const bool use_uring = Config::getB("proc_io_uring");
+			static bool used_uring{};
+			if (use_uring and not used_uring) uring_failed = false;
+			used_uring = use_uring;
+
+			//? Cold processes are read when their turn comes up, spread evenly over the interval by pid, or when they are selected,
+			//? match the filter or called exec. Skipped processes keep their last values and are only checked for existence
+			static vector<size_t> scan_list;
+			std::span<const size_t> scan = pids;
+			if (cold_interval > 0 and not wake_cold and not pause_proc_list) {
+				static uint64_t tier_tick{};
+				++tier_tick;
+				scan_list.clear();
+				for (const auto pid : pids) {
+					const auto tier = tiers.find(pid);
+					const auto index = pid_index.find(pid);
+					if (tier != tiers.end() and tier->second.cold() and index != pid_index.end()
+					and (tier_tick + pid) % cold_interval != 0 and not exec_pids.contains(pid)
+					and pid != detailed_pid and pid != static_cast<size_t>(Proc::selected_pid)
+					and (filter.empty() or current_procs[index->second].filtered)) {
+						auto& proc = current_procs[index->second];
+						proc.cpu_p = proc.wait_p = proc.io_read_s = proc.io_write_s = proc.minflt_s = proc.majflt_s = 0.0;
+						found.insert(pid);
+					}
+					else scan_list.push_back(pid);
 				}
+				scan = scan_list;
+			}
 
-				found.push_back(pid);
-
-				//? Check if pid already exists in current_procs
-				auto find_old = rng::find(current_procs, pid, &proc_info::pid);
-				bool no_cache{};
-				//? Only add new processes if not paused
-				if (find_old == current_procs.end()) {
-					if (not pause_proc_list) {
-						current_procs.push_back({pid});
-						find_old = current_procs.end() - 1;
-						no_cache = true;
-					}
-					else continue;
-				}
-				else if (dead_procs.contains(pid)) continue;
-
-				auto& new_proc = *find_old;
-
-				//? Get program name, command and username
-				if (no_cache) {
-					pread.open(d.path() / "comm");
-					if (not pread.good()) continue;
-					getline(pread, new_proc.name);
-					pread.close();
-					//? Check for whitespace characters in name and set offset to get correct fields from stat file
-					new_proc.name_offset = rng::count(new_proc.name, ' ');
-
-					pread.open(d.path() / "cmdline");
-					if (not pread.good()) continue;
-					long_string.clear();
-					while(getline(pread, long_string, '\0')) {
-						new_proc.cmd += long_string + ' ';
-						if (new_proc.cmd.size() > 1000) {
-							new_proc.cmd.resize(1000);
-							break;
-						}
-					}
-					pread.close();
-					if (not new_proc.cmd.empty()) new_proc.cmd.pop_back();
+			constexpr size_t shard_size = 64;
+			const size_t shards = (scan.size() + shard_size - 1) / shard_size;
+			if (batches.size() < shards) batches.resize(shards);
+			atomic<size_t> next_shard{};
 
-					pread.open(d.path() / "status");
-					if (not pread.good()) continue;
-					string uid;
-					string line;
-					while (pread.good()) {
-						getline(pread, line, ':');
-						if (line == "Uid") {
-							pread.ignore();
-							getline(pread, uid, '\t');
-							break;
-						} else {
-							pread.ignore(SSmax, '\n');
-						}
-					}
-					pread.close();
-					if (uid_user.contains(uid)) {
-						new_proc.user = uid_user.at(uid);
-					}
-					else {
-					#if !(defined(STATIC_BUILD) && defined(__GLIBC__))
-						try {
-							struct passwd* udet;
-							udet = getpwuid(stoi(uid));
-							if (udet != nullptr and udet->pw_name != nullptr) {
-								new_proc.user = string(udet->pw_name);
-							}
-							else {
-								new_proc.user = uid;
-							}
+			workers.run([&] {
+				for (size_t shard; (shard = next_shard.fetch_add(1, std::memory_order_relaxed)) < shards;) {
+					batches[shard].clear();
+					const size_t start = shard * shard_size;
+					scan_pids(scan.subspan(start, min(shard_size, scan.size() - start)), batches[shard], pause_proc_list, totalMem, schedstat, read_io, use_uring);
+				}
+			});
+
+			if (Runner::stopping)
+				return current_procs;
+
+			//? Merge batches into current_procs
+			uint64_t late_ticks{}, total_ticks{};
+			for (auto& batch : std::span{batches}.first(shards)) {
+				for (auto& sample : batch) {
+					const auto pid = sample.pid;
+					const auto& stat = sample.stat;
+					auto find_old = pid_index.find(pid);
+					if (sample.fresh) {
+						if (find_old != pid_index.end()) current_procs.at(find_old->second) = {pid};
+						else {
+							find_old = pid_index.emplace(pid, current_procs.size()).first;
+							current_procs.push_back({pid});
 						}
-						catch (...) { new_proc.user = uid; }
-					#else
-						new_proc.user = uid;
-					#endif
 					}
-				}
+					else if (dead_procs.contains(pid)) continue;
 
-				//? Parse /proc/[pid]/stat
-				pread.open(d.path() / "stat");
-				if (not pread.good()) continue;
+					found.insert(pid);
+					auto& new_proc = current_procs.at(find_old->second);
 
-				const auto& offset = new_proc.name_offset;
-				short_str.clear();
-				int x = 0, next_x = 3;
-				uint64_t cpu_t = 0;
-				try {
-					for (;;) {
-						while (pread.good() and ++x < next_x + offset) pread.ignore(SSmax, ' ');
-						if (not pread.good()) break;
-						else getline(pread, short_str, ' ');
-
-						switch (x-offset) {
-							case 3: //? Process state
-								new_proc.state = short_str.at(0);
-								if (new_proc.ppid != 0) next_x = 14;
-								continue;
-							case 4: //? Parent pid
-								new_proc.ppid = stoull(short_str);
-								next_x = 14;
-								continue;
-							case 14: //? Process utime
-								cpu_t = stoull(short_str);
-								continue;
-							case 15: //? Process stime
-								cpu_t += stoull(short_str);
-								next_x = 19;
-								continue;
-							case 19: //? Nice value
-								new_proc.p_nice = stoll(short_str);
-								continue;
-							case 20: //? Number of threads
-								new_proc.threads = stoull(short_str);
-								if (new_proc.cpu_s == 0) {
-									next_x = 22;
-									new_proc.cpu_t = cpu_t;
-								}
-								else
-									next_x = 24;
-								continue;
-							case 22: //? Get cpu seconds if missing
-								new_proc.cpu_s = stoull(short_str);
-								next_x = 24;
-								continue;
-							case 24: //? RSS memory (can be inaccurate, but parsing smaps increases total cpu usage by ~20x)
-								if (cmp_greater(short_str.size(), totalMem_len))
-									new_proc.mem = totalMem;
-								else
-									new_proc.mem = stoull(short_str) * Shared::pageSize;
+					//? Program name is read from stat, command and username are read by materialize() when needed
+					if (sample.info) {
+						new_proc.name = std::move(sample.name);
+						pending_info.insert(pid);
+					}
+
+					new_proc.state = stat.state;
+					if (tree and (sample.fresh or new_proc.ppid != static_cast<uint64_t>(stat[4]))) tree_links.link(pid, stat[4]);
+					new_proc.ppid = stat[4];
+					new_proc.p_nice = stat[19];
+					new_proc.threads = stat[20];
+					const uint64_t cpu_t = stat[14] + stat[15];
+					const uint64_t cpu_ct = stat[16] + stat[17];
+
+					//? Cpu usage of processes read after being skipped in the cold tier is averaged over the updates since they were last read,
+					//? cpu time they used while skipped is counted as shown late
+					uint64_t cpu_window = cputimes - old_cputimes;
+					if (cold_interval > 0) {
+						auto& tier = tiers[pid];
+						const bool changed = sample.fresh or cpu_t != new_proc.cpu_t or sample.mem != new_proc.mem;
+						const uint64_t used = cpu_t > new_proc.cpu_t ? cpu_t - new_proc.cpu_t : 0;
+						if (tier.cold() and tier.cputimes != 0) {
+							cpu_window = cputimes - tier.cputimes;
+							if (cpu_window > cputimes - old_cputimes) late_ticks += used;
 						}
-						break;
+						total_ticks += used;
+						tier.idle = changed ? 0 : min(tier.idle + 1, cold_after);
+						tier.cputimes = cputimes;
 					}
 
-				}
-				catch (const std::invalid_argument&) { continue; }
-				catch (const std::out_of_range&) { continue; }
+					if (new_proc.cpu_s == 0) {
+						new_proc.cpu_s = stat[22];
+						new_proc.cpu_t = cpu_t;
+						new_proc.cpu_ct = cpu_ct;
+						new_proc.minflt = stat[10];
+						new_proc.majflt = stat[12];
+					}
+					new_proc.mem = sample.mem;
 
-				pread.close();
+					//? Cpu time of children reaped since last update, added to the parent once the dead processes are known
+					if (use_events and not pause_proc_list and cpu_ct > new_proc.cpu_ct) {
+						children_time[pid] = cpu_ct - new_proc.cpu_ct;
+					}
+					new_proc.cpu_ct = cpu_ct;
 
-				if (should_filter_kernel and new_proc.ppid == KTHREADD) {
-					kernels_procs.emplace(new_proc.pid);
-					found.pop_back();
-				}
+					if (should_filter_kernel and new_proc.ppid == KTHREADD) {
+						kernels_procs.emplace(new_proc.pid);
+						found.erase(new_proc.pid);
+					}
 
-				if (x-offset < 24) continue;
+					//? Process cpu usage since last update
+					new_proc.cpu_p = clamp(round(cmult * 1000 * (cpu_t - new_proc.cpu_t) / max((uint64_t)1, cpu_window)) / 10.0, 0.0, 100.0 * Shared::coreCount);
 
-				//? Get RSS memory from /proc/[pid]/statm if value from /proc/[pid]/stat looks wrong
-				if (new_proc.mem >= totalMem) {
-					pread.open(d.path() / "statm");
-					if (not pread.good()) continue;
-					pread.ignore(SSmax, ' ');
-					pread >> new_proc.mem;
-					new_proc.mem *= Shared::pageSize;
-					pread.close();
-				}
+					//? Replaced by nanosecond on cpu time from schedstat if enabled, processes skipped in the cold tier cover a longer window
+					if (sample.sched and sched_window_ns > 0 and new_proc.run_ns != 0 and sample.run_ns >= new_proc.run_ns and sample.wait_ns >= new_proc.wait_ns) {
+						const double window_ns = sched_window_ns * cpu_window / max((uint64_t)1, cputimes - old_cputimes);
+						new_proc.cpu_p = clamp(cmult * 100.0 * (sample.run_ns - new_proc.run_ns) / (window_ns * Shared::coreCount), 0.0, 100.0 * Shared::coreCount);
+						new_proc.wait_p = 100.0 * (sample.wait_ns - new_proc.wait_ns) / window_ns;
+					}
+					else new_proc.wait_p = 0.0;
+					new_proc.run_ns = sample.run_ns;
+					new_proc.wait_ns = sample.wait_ns;
+
+					//? Storage io rates, kept between reads and cleared for processes whose io can't be read
+					if (sample.io) {
+						const bool valid = new_proc.io_time > 0 and io_time > new_proc.io_time
+										and sample.io_read >= new_proc.io_read and sample.io_write >= new_proc.io_write;
+						const double seconds = valid ? (io_time - new_proc.io_time) / 1'000'000.0 : 1.0;
+						new_proc.io_read_rate = valid ? (sample.io_read - new_proc.io_read) / seconds : 0.0;
+						new_proc.io_write_rate = valid ? (sample.io_write - new_proc.io_write) / seconds : 0.0;
+						new_proc.io_read = sample.io_read;
+						new_proc.io_write = sample.io_write;
+						new_proc.io_time = io_time;
+					}
+					else if (read_io or not proc_io) {
+						new_proc.io_read_rate = new_proc.io_write_rate = 0.0;
+						new_proc.io_time = 0;
+					}
+					new_proc.io_read_s = new_proc.io_read_rate;
+					new_proc.io_write_s = new_proc.io_write_rate;
 
-				//? Process cpu usage since last update
-				new_proc.cpu_p = clamp(round(cmult * 1000 * (cpu_t - new_proc.cpu_t) / max((uint64_t)1, cputimes - old_cputimes)) / 10.0, 0.0, 100.0 * Shared::coreCount);
+					//? Page faults per second over the cpu time window, which also covers processes skipped in the cold tier
+					const uint64_t minflt = stat[10], majflt = stat[12];
+					const double fault_seconds = static_cast<double>(max((uint64_t)1, cpu_window)) / (Shared::clkTck * Shared::coreCount);
+					new_proc.minflt_s = minflt >= new_proc.minflt ? (minflt - new_proc.minflt) / fault_seconds : 0.0;
+					new_proc.majflt_s = majflt >= new_proc.majflt ? (majflt - new_proc.majflt) / fault_seconds : 0.0;
+					new_proc.minflt = minflt;
+					new_proc.majflt = majflt;
 
-				//? Process cumulative cpu usage since process start
-				new_proc.cpu_c = (double)cpu_t / max(1.0, (uptime * Shared::clkTck) - new_proc.cpu_s);
+					//? Process cumulative cpu usage since process start
+					new_proc.cpu_c = (double)cpu_t / max(1.0, (uptime * Shared::clkTck) - new_proc.cpu_s);
 
-				//? Update cached value with latest cpu times
-				new_proc.cpu_t = cpu_t;
+					//? Update cached value with latest cpu times
+					new_proc.cpu_t = cpu_t;
 
-				if (show_detailed and not got_detailed and new_proc.pid == detailed_pid) {
-					got_detailed = true;
+					if (show_detailed and not got_detailed and new_proc.pid == detailed_pid) {
+						got_detailed = true;
+					}
 				}
 			}
 
+			//? Close cached stat descriptors of processes that are gone or filtered out
+			stat_fds.prune(found);
+			schedstat_fds.prune(found);
+			io_fds.prune(found);
+			std::erase_if(pending_info, [&](size_t pid) { return not found.contains(pid); });
+			std::erase_if(quarantine, [&](const auto& entry) { return not found.contains(entry.first); });
+
+			//? Share of process cpu time shown late because of the cold tier, decayed over roughly the last 10 updates
+			if (cold_interval > 0) {
+				static double late_sum{}, total_sum{};
+				late_sum = 0.9 * late_sum + late_ticks;
+				total_sum = 0.9 * total_sum + total_ticks;
+				std::erase_if(tiers, [&](const auto& entry) { return not found.contains(entry.first); });
+				cold_procs = static_cast<int>(rng::count_if(tiers, [](const auto& entry) { return entry.second.cold(); }));
+				stale_cpu = total_sum > 0 ? 100.0 * late_sum / total_sum : 0.0;
+			}
+
 			//? Clear dead processes from current_procs and remove kernel processes if enabled and not paused
 			if (not pause_proc_list) {
-				auto eraser = rng::remove_if(current_procs, [&](const auto& element){ return not v_contains(found, element.pid); });
-				current_procs.erase(eraser.begin(), eraser.end());
+				//? Cpu time of reaped children that was already shown for the children themselves is not added to the parent again,
+				//? what is left belongs to children that exited before they could be seen by a scan
+				if (not children_time.empty()) {
+					for (const auto& p : current_procs) {
+						if (found.contains(p.pid)) continue;
+						if (auto parent = children_time.find(p.ppid); parent != children_time.end())
+							parent->second -= min(parent->second, p.cpu_t);
+					}
+				}
+				std::erase_if(pid_index, [&](const auto& entry){ return not found.contains(entry.first); });
+				std::erase_if(current_procs, [&](const auto& element) {
+					if (found.contains(element.pid)) return false;
+					if (tree) tree_links.unlink(element.pid);
+					return true;
+				});
+				reindex_procs();
+				for (const auto& [pid, child_t] : children_time) {
+					if (auto parent = pid_index.find(pid); child_t > 0 and parent != pid_index.end()) {
+						auto& p = current_procs.at(parent->second);
+						p.cpu_p = clamp(p.cpu_p + round(cmult * 1000 * child_t / max((uint64_t)1, cputimes - old_cputimes)) / 10.0, 0.0, 100.0 * Shared::coreCount);
+					}
+				}
+				children_time.clear();
 				if (!dead_procs.empty()) dead_procs.clear();
 			}
 			//? Set correct state of dead processes if paused
 			else {
 				const bool keep_dead_proc_usage = Config::getB("keep_dead_proc_usage");
 				for (auto& r : current_procs) {
-					if (rng::find(found, r.pid) == found.end()) {
+					if (not found.contains(r.pid)) {
 						if (r.state != 'X') r.death_time = round(uptime) - (r.cpu_s / Shared::clkTck);
 						r.state = 'X';
 						dead_procs.emplace(r.pid);
@@ -3498,8 +5291,16 @@ namespace Proc {
 				}
 			}
 
+			//? Pss, uss and swap from the background sampler, which is handed the processes for its next round
+			if (Config::getB("proc_pss")) {
+				rollup_samples.apply(current_procs);
+				rollup_samples.update(current_procs, std::chrono::milliseconds(Config::getI("proc_pss_budget")));
+			}
+			else rollup_samples.clear();
+
 			//? Update the details info box for process if active
 			if (show_detailed and got_detailed) {
+				materialize(detailed_pid);
 				_collect_details(detailed_pid, round(uptime), current_procs);
 			}
 			else if (show_detailed and not got_detailed and detailed.status != "Dead") {
@@ -3507,46 +5308,131 @@ namespace Proc {
 				redraw = true;
 			}
 
+			//? Record cpu and memory history of all processes
+			history.record(current_procs);
+
+			//? Read threads of multithreaded processes for thread mode and the detailed view
+			if (threads_mode or show_detailed) {
+				const bool update_rows = threads_mode and (not pause_proc_list or threads_mode_change);
+				std::erase_if(task_caches, [&](const auto& entry) {
+					return not pid_index.contains(entry.first) or not (threads_mode or (show_detailed and entry.first == detailed_pid));
+				});
+				if (update_rows) thread_procs.clear();
+				for (const auto& p : current_procs) {
+					const bool is_detailed = show_detailed and got_detailed and p.pid == detailed_pid;
+					if (not update_rows and not is_detailed) continue;
+					if (p.threads <= 1 or p.state == 'X') {
+						if (update_rows) thread_procs.push_back(p);
+						continue;
+					}
+					auto& cache = task_caches[p.pid];
+					scan_tasks(p, cache, cputimes - old_cputimes, cmult, uptime);
+					if (update_rows) thread_procs.insert(thread_procs.end(), cache.tasks.begin(), cache.tasks.end());
+					if (is_detailed) {
+						detailed.top_threads.assign(cache.tasks.begin(), cache.tasks.end());
+						rng::stable_sort(detailed.top_threads, rng::greater{}, &proc_info::cpu_p);
+						if (detailed.top_threads.size() > 8) detailed.top_threads.resize(8);
+					}
+				}
+			}
+			else task_caches.clear();
+			if (not threads_mode and not thread_procs.empty()) thread_procs.clear();
+			if (show_detailed and (not got_detailed or detailed.entry.threads <= 1)) detailed.top_threads.clear();
+
 			old_cputimes = cputimes;
 		}
 		//* ---------------------------------------------Collection done-----------------------------------------------
 
+		//? Group mode shows one row per program, rebuilt from the processes after each update
+		static vector<proc_info> group_procs;
+		if (group_mode and (group_mode_change or (not no_update and not pause_proc_list))) {
+			group_programs(current_procs, group_procs);
+			if (not filter.empty()) should_filter = true;
+		}
+		else if (not group_mode and not group_procs.empty()) group_procs.clear();
+		if (group_mode_change and not filter.empty()) should_filter = true;
+
+		//? Thread mode shows the rows in thread_procs instead of the processes
+		auto& procs = group_mode ? group_procs : threads_mode ? thread_procs : current_procs;
+
+		//? Filters and sorting by command or user need those fields for every process
+		if (not filter.empty() or sorting == "command" or sorting == "user") materialize_all(procs);
+
 		//* Match filter if defined
 		if (should_filter) {
+			bool narrowed{};
+			const auto& matcher = compiled_filter(filter, narrowed);
+			//? If only the filter changed and the new filter narrows down the previous one, processes that were filtered out stay filtered out
+			narrowed = narrowed and no_update and not tree and not tree_mode_change;
 			filter_found = 0;
-			for (auto& p : current_procs) {
-				if (not tree and not filter.empty()) {
-					if (!matches_filter(p, filter)) {
-						p.filtered = true;
-						filter_found++;
+
+			//? The trigram index narrows substring filters down to the rows containing all trigrams of the substrings
+			//? It is only synced for filters it can look up, and kept for a minute after the last such filter so a new filter doesn't rebuild it
+			static trigram_index filter_index;
+			static vector<size_t> candidates;
+			static uint64_t index_unused_since{};
+			constexpr uint64_t index_keep_ms = 60'000;
+			const bool keep_index = Config::getB("proc_filter_index") and not tree;
+			const bool use_index = keep_index and trigram_index::usable(matcher);
+			if (use_index) {
+				filter_index.sync(procs);
+				index_unused_since = 0;
+			}
+			else if (not filter_index.empty()) {
+				if (index_unused_since == 0) index_unused_since = time_ms();
+				//? The index holds the strings of processes that exited since the last sync, and memory in proportion to all command lines
+				if (not keep_index or time_ms() - index_unused_since > index_keep_ms) {
+					filter_index.clear();
+					index_unused_since = 0;
+				}
+			}
+
+			if (use_index and filter_index.candidates(matcher, candidates)) {
+				std::erase_if(candidates, [&](const size_t row) { return (narrowed and procs[row].filtered) or not matcher(procs[row]); });
+				for (auto& p : procs) p.filtered = true;
+				for (const auto row : candidates) procs[row].filtered = false;
+				filter_found = procs.size() - candidates.size();
+			}
+			else {
+				for (auto& p : procs) {
+					if (not tree and not filter.empty()) {
+						if ((narrowed and p.filtered) or not matcher(p)) {
+							p.filtered = true;
+							filter_found++;
+						} else {
+							p.filtered = false;
+						}
 					} else {
 						p.filtered = false;
 					}
-				} else {
-					p.filtered = false;
 				}
 			}
 		}
 
-		//* Sort processes
-		if ((sorted_change or tree_mode_change) or (not no_update and not pause_proc_list)) {
-			proc_sorter(current_procs, sorting, reverse, tree);
+		//* Sort processes, in tree mode only siblings are sorted when the tree is generated
+		//? Only the rows up to one page below the visible rows need to be sorted when the whole list isn't filtered or searched for a followed process
+		static size_t sorted_limit{};
+		const bool scrolled_past_sorted = sorted_limit != 0 and cmp_greater(Config::getI("proc_start") + Proc::select_max, sorted_limit);
+		if (not tree and ((sorted_change or tree_mode_change or threads_mode_change or group_mode_change or scrolled_past_sorted) or (not no_update and not pause_proc_list))) {
+			sorted_limit = (filter_found > 0 or Config::getB("follow_process") or Proc::select_max <= 0) ? 0 : Config::getI("proc_start") + 2 * Proc::select_max;
+			proc_sorter(procs, sorting, reverse, false, sorted_limit);
 		}
 
 		//* Generate tree view if enabled
 		if (tree and (not no_update or should_filter or sorted_change)) {
 			bool locate_selection = false;
 
+			//? The links are patched while collecting, they are only built from all processes when entering tree mode
+			if (tree_mode_change or tree_links.parents.size() != current_procs.size()) {
+				tree_links.clear();
+				for (const auto& p : current_procs) tree_links.link(p.pid, p.ppid);
+			}
+
 			if (toggle_children != -1) {
-				auto collapser = rng::find(current_procs, toggle_children, &proc_info::pid);
-				if (collapser != current_procs.end()){
-					for (auto& p : current_procs) {
-						if (p.ppid == collapser->pid) {
-							auto child = rng::find(current_procs, p.pid, &proc_info::pid);
-							if (child != current_procs.end()){
-								child->collapsed = not child->collapsed;
-							}
-						}
+				if (auto children = tree_links.children.find(toggle_children); children != tree_links.children.end()) {
+					for (const auto child : children->second) {
+						if (auto pos = pid_index.find(child); pos != pid_index.end())
+							current_procs[pos->second].collapsed = not current_procs[pos->second].collapsed;
 					}
 					if (Config::ints.at("proc_selected") > 0) locate_selection = true;
 				}
@@ -3554,8 +5440,8 @@ namespace Proc {
 			}
 
 			if (auto find_pid = (collapse != -1 ? collapse : expand); find_pid != -1) {
-				auto collapser = rng::find(current_procs, find_pid, &proc_info::pid);
-				if (collapser != current_procs.end()) {
+				if (auto find_collapser = pid_index.find(find_pid); find_collapser != pid_index.end()) {
+					auto collapser = current_procs.begin() + find_collapser->second;
 					if (collapse == expand) {
 						collapser->collapsed = not collapser->collapsed;
 					}
@@ -3581,21 +5467,13 @@ namespace Proc {
 			vector<tree_proc> tree_procs;
 			tree_procs.reserve(current_procs.size());
 
-			if (!pause_proc_list) {
-				for (auto& p : current_procs) {
-					if (not v_contains(found, p.ppid)) p.ppid = 0;
-				}
-			}
-
-			//? Stable sort to retain selected sorting among processes with the same parent
-			rng::stable_sort(current_procs, rng::less{}, & proc_info::ppid);
-
 			//? Auto-collapse processes with many children when entering tree mode
 			_auto_collapse_oversized(current_procs, tree_mode_change);
 
-			//? Start recursive iteration over processes with the lowest shared parent pids
-			for (auto& p : rng::equal_range(current_procs, current_procs.at(0).ppid, rng::less{}, &proc_info::ppid)) {
-				_tree_gen(p, current_procs, tree_procs, 0, false, filter, false, no_update, should_filter);
+			//? Start recursive iteration over processes whose parent isn't known, siblings are put in order by tree_sort()
+			for (const auto root : tree_links.roots) {
+				if (auto pos = pid_index.find(root); pos != pid_index.end())
+					_tree_gen(current_procs[pos->second], current_procs, tree_links, pid_index, tree_procs, 0, false, filter, false, no_update, should_filter);
 			}
 
 			//? Recursive sort over tree structure to account for collapsed processes in the tree
@@ -3608,7 +5486,7 @@ namespace Proc {
 			}
 
 			//? Final sort based on tree index
-			rng::stable_sort(current_procs, rng::less {}, &proc_info::tree_index);
+			sort_by_tree_index();
 
 			//? Move current selection/view to the selected process when collapsing/expanding in the tree
 			if (locate_selection) {
@@ -3618,10 +5496,296 @@ namespace Proc {
 				Config::ints.at("proc_selected") = loc - Config::ints.at("proc_start") + 1;
 			}
 		}
+		else if (not tree and not tree_links.parents.empty()) tree_links.clear();
+
+		reindex_procs();
+		numpids = (int)procs.size() - filter_found;
+
+		//? Read cmd and user of the rows from one page above to one page below the visible rows and of the selected process
+		static vector<proc_info*> window;
+		window.clear();
+		if (Proc::select_max > 0) {
+			const int start = Config::getI("proc_start");
+			const int first = max(0, start - Proc::select_max), last = start + 2 * Proc::select_max;
+			for (int n = 0; auto& p : procs) {
+				if (p.filtered or (tree and p.tree_index == procs.size())) continue;
+				if (n >= last) break;
+				if (n++ >= first) window.push_back(&p);
+			}
+		}
+		materialize(window, {static_cast<size_t>(Proc::selected_pid), static_cast<size_t>(Config::getI("followed_pid"))});
+
+		return procs;
+	}
+}
+
+namespace Cgroup {
+	cgroup_stats current_stats;
+
+	enum cgroup_file { cpu_stat, memory_current, memory_stat, io_stat, file_count };
+	constexpr array<const char*, file_count> file_names = {"cpu.stat", "memory.current", "memory.stat", "io.stat"};
+	constexpr int fd_closed = -1, fd_missing = -2;
+
+	struct cgroup_node {
+		string path;							//? Relative to the hierarchy root, empty for the root itself
+		size_t depth{};
+		size_t parent{};
+		array<int, file_count> fds{fd_closed, fd_closed, fd_closed, fd_closed};
+		uint64_t usage_usec{}, rbytes{}, wbytes{};
+		bool sampled{};
+		cgroup_info info{};
+	};
+
+	static vector<cgroup_node> nodes;
+	static int root_fd = -1, inotify_fd = -1;
+	static int open_fds{}, fd_budget{};
+	static bool rewalk{true}, watches_failed{};
+	static uint64_t last_sample{}, walk_count{};
+	static bool initialized{};
+
+	static void init() {
+		initialized = true;
+		current_stats.root = cgroup2_root();
+		if (current_stats.root.empty()) return;
+		root_fd = open(current_stats.root.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+		if (root_fd < 0) {
+			Logger::warning("Cgroup: failed to open {}: {}", current_stats.root, strerror(errno));
+			return;
+		}
+		current_stats.available = true;
+
+		//? Keep at most a quarter of the allowed number of open files as persistent cgroup file descriptors
+		struct rlimit limit{};
+		if (getrlimit(RLIMIT_NOFILE, &limit) == 0 and limit.rlim_cur != RLIM_INFINITY)
+			fd_budget = static_cast<int>(min<rlim_t>(limit.rlim_cur / 4, 4096));
+		else
+			fd_budget = 256;
+
+		inotify_fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+		if (inotify_fd < 0) {
+			watches_failed = true;
+			Logger::debug("Cgroup: inotify unavailable, rescanning hierarchy every 16 updates");
+		}
+	}
+
+	static void close_files(cgroup_node& node) {
+		for (auto& fd : node.fds) {
+			if (fd >= 0) {
+				close(fd);
+				open_fds--;
+			}
+			fd = fd_closed;
+		}
+	}
+
+	//* Watch <path> for created and removed child groups, falls back to periodic rescans if the watch limit is reached
+	static void add_watch(const string& path) {
+		if (inotify_fd < 0 or watches_failed) return;
+		if (inotify_add_watch(inotify_fd, path.c_str(), IN_CREATE | IN_DELETE | IN_ONLYDIR) < 0) {
+			watches_failed = true;
+			Logger::debug("Cgroup: inotify_add_watch failed: {}, rescanning hierarchy every 16 updates", strerror(errno));
+		}
+	}
+
+	//* Walk the hierarchy below <rel> depth first and add all groups found to <out>
+	static void walk(const string& rel, size_t depth, size_t parent, vector<cgroup_node>& out) {
+		const int dir_fd = openat(root_fd, rel.empty() ? "." : rel.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+		if (dir_fd < 0) return;
+		static dir_scanner scanner;
+		vector<string> children;
+		scanner.each(dir_fd, [&](std::string_view name, unsigned char type) {
+			if (type != DT_DIR or name.starts_with('.')) return;
+			children.push_back(rel.empty() ? string{name} : rel + '/' + string{name});
+		});
+		close(dir_fd);
+
+		for (auto& child : children) {
+			const size_t index = out.size();
+			out.push_back({.path = std::move(child), .depth = depth + 1, .parent = parent});
+			out.back().info.name = out.back().path.substr(out.back().path.find_last_of('/') + 1);
+			add_watch(current_stats.root + '/' + out.back().path);
+			walk(out.at(index).path, depth + 1, index, out);
+		}
+	}
+
+	//* Rebuild the list of groups, file descriptors and previous counters of groups still present are kept
+	static void rescan() {
+		std::unordered_map<string, cgroup_node> old;
+		old.reserve(nodes.size());
+		for (auto& node : nodes) old.emplace(node.path, std::move(node));
+
+		vector<cgroup_node> found;
+		found.push_back({});
+		add_watch(current_stats.root);
+		walk("", 0, 0, found);
+
+		for (auto& node : found) {
+			auto it = old.find(node.path);
+			if (it == old.end()) continue;
+			node.fds = it->second.fds;
+			node.usage_usec = it->second.usage_usec;
+			node.rbytes = it->second.rbytes;
+			node.wbytes = it->second.wbytes;
+			node.sampled = it->second.sampled;
+			//? A controller could have been enabled since the last walk
+			for (auto& fd : node.fds) if (fd == fd_missing) fd = fd_closed;
+			it->second.fds.fill(fd_closed);
+		}
+		for (auto& [path, node] : old) close_files(node);
+
+		nodes = std::move(found);
+		walk_count = 0;
+		rewalk = false;
+	}
+
+	//* Check for groups created or removed since the last update
+	static void read_events() {
+		if (inotify_fd < 0) return;
+		alignas(inotify_event) char buf[4096];
+		ssize_t len;
+		while ((len = read(inotify_fd, buf, sizeof(buf))) > 0) {
+			for (char* ptr = buf; ptr < buf + len; ptr += sizeof(inotify_event) + reinterpret_cast<inotify_event*>(ptr)->len) {
+				const auto* event = reinterpret_cast<inotify_event*>(ptr);
+				if (event->mask & IN_Q_OVERFLOW or (event->mask & (IN_CREATE | IN_DELETE) and event->mask & IN_ISDIR))
+					rewalk = true;
+			}
+		}
+	}
+
+	//* Read a file of <node> into <buf>, the file descriptor is kept open for the next update while within the budget
+	static std::string_view read_file(cgroup_node& node, cgroup_file file, std::span<char> buf) {
+		int& fd = node.fds.at(file);
+		if (fd == fd_missing) return {};
+		bool keep = true;
+		if (fd == fd_closed) {
+			const string path = node.path.empty() ? file_names.at(file) : node.path + '/' + file_names.at(file);
+			fd = openat(root_fd, path.c_str(), O_RDONLY | O_CLOEXEC);
+			if (fd < 0) {
+				fd = (errno == ENOENT ? fd_missing : fd_closed);
+				return {};
+			}
+			keep = open_fds < fd_budget;
+			if (keep) open_fds++;
+		}
+		ssize_t len;
+		do len = pread(fd, buf.data(), buf.size(), 0); while (len < 0 and errno == EINTR);
+		if (not keep or len < 0) {
+			close(fd);
+			if (keep) open_fds--;
+			fd = fd_closed;
+			//? The group was removed since the last walk
+			if (len < 0) rewalk = true;
+		}
+		return len > 0 ? std::string_view{buf.data(), static_cast<size_t>(len)} : std::string_view{};
+	}
+
+	//* Value of "<key> <value>" line in a flat keyed file
+	static uint64_t keyed_value(std::string_view data, std::string_view key) {
+		for (size_t pos = 0; pos < data.size();) {
+			const auto end = std::min(data.find('\n', pos), data.size());
+			const auto line = data.substr(pos, end - pos);
+			if (line.size() > key.size() and line.starts_with(key) and line[key.size()] == ' ') {
+				uint64_t value{};
+				std::from_chars(line.data() + key.size() + 1, line.data() + line.size(), value);
+				return value;
+			}
+			pos = end + 1;
+		}
+		return 0;
+	}
+
+	//* Sum of "rbytes=" and "wbytes=" of all devices in io.stat
+	static pair<uint64_t, uint64_t> io_bytes(std::string_view data) {
+		uint64_t read_total{}, write_total{};
+		const auto field = [&data](size_t pos, std::string_view name, size_t end) -> uint64_t {
+			const auto at = data.substr(0, end).find(name, pos);
+			if (at == std::string_view::npos) return 0;
+			uint64_t value{};
+			std::from_chars(data.data() + at + name.size(), data.data() + end, value);
+			return value;
+		};
+		for (size_t pos = 0; pos < data.size();) {
+			const auto end = std::min(data.find('\n', pos), data.size());
+			read_total += field(pos, " rbytes=", end);
+			write_total += field(pos, " wbytes=", end);
+			pos = end + 1;
+		}
+		return {read_total, write_total};
+	}
+
+	auto collect(bool no_update) -> cgroup_stats& {
+		if (Runner::stopping) return current_stats;
+		if (not initialized) init();
+		if (no_update or not current_stats.available) return current_stats;
+
+		read_events();
+		if (watches_failed and ++walk_count >= 16) rewalk = true;
+		if (rewalk or nodes.empty()) rescan();
+
+		const uint64_t now = time_micros();
+		const double elapsed = last_sample > 0 ? static_cast<double>(now - last_sample) : 0.0;
+		last_sample = now;
+		array<char, 1024> buf;
+
+		//? Root is skipped, it has no memory.current and its cpu.stat covers the whole system
+		for (auto& node : nodes | rng::views::drop(1)) {
+			auto& info = node.info;
+			const uint64_t usage = keyed_value(read_file(node, cpu_stat, buf), "usage_usec");
+			info.cpu_p = (node.sampled and elapsed > 0 and usage >= node.usage_usec)
+				? clamp((usage - node.usage_usec) * 100.0 / (elapsed * Shared::coreCount), 0.0, 100.0) : 0.0;
+			node.usage_usec = usage;
+
+			const auto current = read_file(node, memory_current, buf);
+			info.has_mem = not current.empty();
+			if (info.has_mem) {
+				std::from_chars(current.data(), current.data() + current.size(), info.mem);
+				//? anon and file are the first lines of memory.stat, the rest of the file is not needed
+				const auto stat = read_file(node, memory_stat, buf);
+				info.anon = keyed_value(stat, "anon");
+				info.file = keyed_value(stat, "file");
+			}
+
+			const auto io = read_file(node, io_stat, std::span{buf});
+			info.has_io = node.fds.at(io_stat) != fd_missing;
+			const auto [rbytes, wbytes] = io_bytes(io);
+			info.io_read = (node.sampled and elapsed > 0 and rbytes >= node.rbytes) ? round((rbytes - node.rbytes) * 1'000'000.0 / elapsed) : 0;
+			info.io_write = (node.sampled and elapsed > 0 and wbytes >= node.wbytes) ? round((wbytes - node.wbytes) * 1'000'000.0 / elapsed) : 0;
+			node.rbytes = rbytes;
+			node.wbytes = wbytes;
+			node.sampled = true;
+		}
+
+		//? Sort siblings by usage and flatten the tree depth first
+		const auto& sorting = Config::getS("cgroup_sorting");
+		const auto usage_key = [&sorting](const cgroup_info& info) -> double {
+			if (sorting == "memory") return static_cast<double>(info.mem);
+			if (sorting == "io") return static_cast<double>(info.io_read + info.io_write);
+			return info.cpu_p;
+		};
+		vector<vector<size_t>> children(nodes.size());
+		for (size_t i = 1; i < nodes.size(); i++) children.at(nodes.at(i).parent).push_back(i);
+		for (auto& siblings : children) {
+			rng::stable_sort(siblings, [&](size_t a, size_t b) {
+				const auto& info_a = nodes.at(a).info;
+				const auto& info_b = nodes.at(b).info;
+				const double key_a = usage_key(info_a), key_b = usage_key(info_b);
+				if (key_a != key_b) return key_a > key_b;
+				return info_a.mem > info_b.mem;
+			});
+		}
 
-		numpids = (int)current_procs.size() - filter_found;
+		auto& groups = current_stats.groups;
+		groups.clear();
+		vector<size_t> stack(children.front().rbegin(), children.front().rend());
+		while (not stack.empty()) {
+			const size_t index = stack.back();
+			stack.pop_back();
+			groups.push_back(nodes.at(index).info);
+			groups.back().depth = nodes.at(index).depth - 1;
+			stack.insert(stack.end(), children.at(index).rbegin(), children.at(index).rend());
+		}
 
-		return current_procs;
+		return current_stats;
 	}
 }
 
@@ -1689,6 +1689,9 @@ namespace Proc {
 			detailed = {};
 			detailed.last_pid = pid;
 			detailed.skip_smaps = not Config::getB("proc_info_smaps");
+			//? Start the graphs from the recorded history of the process
+			history.cpu(pid, detailed.cpu_percent);
+			history.mem(pid, detailed.mem_bytes);
 		}
 
 		//? Copy proc_info for process from proc vector
@@ -1833,6 +1836,7 @@ namespace Proc {
 						}
 						new_proc.name = f_name;
 						//? Get process arguments if possible, fallback to process path in case of failure
+						string cmd;
 						if (Shared::arg_max > 0) {
 							std::unique_ptr<char[]> proc_chars(new char[Shared::arg_max]);
 							int mib[] = {CTL_KERN, KERN_PROCARGS2, (int)pid};
@@ -1843,21 +1847,22 @@ namespace Proc {
 								std::string_view proc_args(proc_chars.get(), argmax);
 								if (size_t null_pos = proc_args.find('\0', sizeof(argc)); null_pos != string::npos) {
 									if (size_t start_pos = proc_args.find_first_not_of('\0', null_pos); start_pos != string::npos) {
-										while (argc-- > 0 and null_pos != string::npos and cmp_less(new_proc.cmd.size(), 1000)) {
+										while (argc-- > 0 and null_pos != string::npos and cmp_less(cmd.size(), 1000)) {
 											null_pos = proc_args.find('\0', start_pos);
-											new_proc.cmd += (string)proc_args.substr(start_pos, null_pos - start_pos) + ' ';
+											cmd += (string)proc_args.substr(start_pos, null_pos - start_pos) + ' ';
 											start_pos = null_pos + 1;
 										}
 									}
 								}
-								if (not new_proc.cmd.empty()) new_proc.cmd.pop_back();
+								if (not cmd.empty()) cmd.pop_back();
 							}
 						}
-						if (new_proc.cmd.empty()) new_proc.cmd = f_name;
-						if (new_proc.cmd.size() > 1000) {
-							new_proc.cmd.resize(1000);
-							new_proc.cmd.shrink_to_fit();
+						if (cmd.empty()) cmd = f_name;
+						if (cmd.size() > 1000) {
+							cmd.resize(1000);
+							cmd.shrink_to_fit();
 						}
+						new_proc.cmd = cmd;
 						new_proc.ppid = kproc.kp_eproc.e_ppid;
 						new_proc.cpu_s = kproc.kp_proc.p_starttime.tv_sec * 1'000'000 + kproc.kp_proc.p_starttime.tv_usec;
 						struct passwd *pwd = getpwuid(kproc.kp_eproc.e_ucred.cr_uid);
@@ -1934,6 +1939,9 @@ namespace Proc {
 					redraw = true;
 				}
 
+				//? Record cpu and memory history of all processes
+				history.record(current_procs);
+
 				old_cputimes = cputimes;
 			}
 		}
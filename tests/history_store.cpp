@@ -0,0 +1,69 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include "btop_config.hpp"
+#include "btop_shared.hpp"
+#include "test_procs.hpp"
+
+#include <gtest/gtest.h>
+
+//* Saves and restores the per core setting so other tests see the configured value
+class history_store : public testing::Test {
+protected:
+	void SetUp() override {
+		per_core = Config::getB("proc_per_core");
+		Config::set("proc_per_core", true);
+	}
+	void TearDown() override { Config::set("proc_per_core", per_core); }
+
+	bool per_core{};
+};
+
+TEST_F(history_store, records_samples) {
+	Proc::history_store store;
+	for (int i = 1; i <= 70; i++)
+		store.record({test::make_proc({.pid = 10, .cpu_p = double(i), .mem = 1ull << 20}), test::make_proc({.pid = 11, .cpu_p = 200})});
+
+	EXPECT_EQ(store.used(), 2);
+	EXPECT_EQ(store.size(10), Proc::history_store::samples);
+
+	std::deque<long long> cpu;
+	store.cpu(10, cpu);
+	ASSERT_EQ(cpu.size(), Proc::history_store::samples);
+	EXPECT_EQ(cpu.front(), 70 - (long long)Proc::history_store::samples + 1);
+	EXPECT_EQ(cpu.back(), 70);
+
+	cpu.clear();
+	store.cpu(11, cpu, 3);
+	EXPECT_EQ(cpu, (std::deque<long long>{100, 100, 100}));
+
+	std::deque<long long> mem;
+	store.mem(10, mem, 1);
+	ASSERT_EQ(mem.size(), 1);
+	EXPECT_NEAR(mem.back(), 1 << 20, (1 << 20) / 1000);
+	mem.clear();
+	store.mem(11, mem, 1);
+	EXPECT_EQ(mem.back(), 0);
+}
+
+TEST_F(history_store, releases_slots) {
+	Proc::history_store store;
+	std::vector<Proc::proc_info> procs;
+	for (size_t pid = 1; pid <= 1000; pid++) procs.push_back(test::make_proc({.pid = pid, .cpu_p = 1}));
+	store.record(procs);
+	EXPECT_EQ(store.used(), 1000);
+	const auto capacity = store.capacity();
+
+	//? Exited processes are dropped and the slab shrinks once most slots are unused
+	procs.resize(10);
+	store.record(procs);
+	EXPECT_EQ(store.used(), 10);
+	EXPECT_LT(store.capacity(), capacity);
+	EXPECT_EQ(store.size(5), 2);
+	EXPECT_EQ(store.size(500), 0);
+
+	//? A reused pid starts a new history
+	procs.at(4).cpu_s = 2;
+	store.record(procs);
+	EXPECT_EQ(store.size(5), 1);
+	EXPECT_EQ(store.size(6), 3);
+}
@@ -0,0 +1,89 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include "btop_shared.hpp"
+#include "test_procs.hpp"
+
+#include <algorithm>
+
+#include <gtest/gtest.h>
+
+TEST(proc_filter, free_text) {
+	const auto proc = test::make_proc({.pid = 1234, .name = "postgres", .cmd = "/usr/bin/postgres -D /var/lib/pgsql", .user = "postgres"});
+	EXPECT_TRUE(Proc::proc_filter{""}(proc));
+	EXPECT_TRUE(Proc::proc_filter{"23"}(proc));
+	EXPECT_TRUE(Proc::proc_filter{"POST"}(proc));
+	EXPECT_TRUE(Proc::proc_filter{"-D /var"}(proc));
+	EXPECT_FALSE(Proc::proc_filter{"mysql"}(proc));
+	EXPECT_TRUE(Proc::proc_filter{"!^post"}(proc));
+	EXPECT_TRUE(Proc::proc_filter{"!"}(proc));
+	EXPECT_FALSE(Proc::proc_filter{"!^/usr/bin/postgres$"}(proc));
+	EXPECT_FALSE(Proc::proc_filter{"!(post"}(proc));
+}
+
+TEST(proc_filter, scoped_terms) {
+	const auto proc = test::make_proc({.pid = 4321, .name = "postgres", .cmd = "/usr/bin/postgres", .user = "postgres", .cpu_p = 12.5, .mem = 2ull << 30, .threads = 8});
+	EXPECT_TRUE(Proc::proc_filter{"user:postgres cpu>5 mem>1G"}(proc));
+	EXPECT_FALSE(Proc::proc_filter{"user:root cpu>5"}(proc));
+	EXPECT_FALSE(Proc::proc_filter{"user:postgres cpu>20"}(proc));
+	EXPECT_FALSE(Proc::proc_filter{"mem>=4GiB"}(proc));
+	EXPECT_TRUE(Proc::proc_filter{"threads=8 pid:432"}(proc));
+	EXPECT_TRUE(Proc::proc_filter{"name:!^post cmd:bin"}(proc));
+	EXPECT_TRUE(Proc::proc_filter{"user:postgres !gres$"}(proc));
+	EXPECT_FALSE(Proc::proc_filter{"user:postgres mysql"}(proc));
+	EXPECT_TRUE(Proc::proc_filter{"user:"}(proc));
+	EXPECT_FALSE(Proc::proc_filter{"cpu>"}(proc));
+}
+
+TEST(proc_filter, narrows) {
+	EXPECT_TRUE(Proc::proc_filter{"post"}.narrows(Proc::proc_filter{"pos"}));
+	EXPECT_TRUE(Proc::proc_filter{"pos"}.narrows(Proc::proc_filter{""}));
+	EXPECT_FALSE(Proc::proc_filter{"pos"}.narrows(Proc::proc_filter{"post"}));
+	EXPECT_TRUE(Proc::proc_filter{"user:postgres cpu>5"}.narrows(Proc::proc_filter{"user:post"}));
+	EXPECT_TRUE(Proc::proc_filter{"cpu>10"}.narrows(Proc::proc_filter{"cpu>5"}));
+	EXPECT_FALSE(Proc::proc_filter{"cpu>5"}.narrows(Proc::proc_filter{"cpu>10"}));
+	EXPECT_FALSE(Proc::proc_filter{"name:post"}.narrows(Proc::proc_filter{"user:post"}));
+	EXPECT_FALSE(Proc::proc_filter{"!^posts"}.narrows(Proc::proc_filter{"!^post"}));
+}
+
+TEST(trigram_index, candidates_cover_matches) {
+	std::vector<Proc::proc_info> procs{
+		test::make_proc({.pid = 100, .name = "java", .cmd = "/usr/bin/java -cp /opt/spark/jars/spark-core.jar Executor", .user = "spark"}),
+		test::make_proc({.pid = 101, .name = "java", .cmd = "/usr/bin/java -cp /opt/kafka/libs/kafka.jar Kafka", .user = "kafka"}),
+		test::make_proc({.pid = 1234, .name = "postgres", .cmd = "/usr/bin/postgres -D /var/lib/pgsql", .user = "postgres"}),
+		test::make_proc({.pid = 2000, .name = "sh", .cmd = "sh", .user = "root"}),
+	};
+	Proc::trigram_index index;
+	index.sync(procs);
+
+	auto matching = [&](const std::string& filter) {
+		const Proc::proc_filter f{filter};
+		std::vector<size_t> rows;
+		EXPECT_TRUE(index.candidates(f, rows)) << filter;
+		std::erase_if(rows, [&](size_t row) { return not f(procs[row]); });
+		std::ranges::sort(rows);
+		return rows;
+	};
+	EXPECT_EQ(matching("SPARK"), (std::vector<size_t>{0}));
+	EXPECT_EQ(matching("java user:kafka"), (std::vector<size_t>{1}));
+	EXPECT_EQ(matching("/usr/bin"), (std::vector<size_t>{0, 1, 2}));
+	EXPECT_EQ(matching("123"), (std::vector<size_t>{2}));
+	EXPECT_EQ(matching("mysql"), (std::vector<size_t>{}));
+
+	//? Short substrings, regexes and comparisons can't be looked up
+	EXPECT_TRUE(Proc::trigram_index::usable(Proc::proc_filter{"sh spark"}));
+	EXPECT_FALSE(Proc::trigram_index::usable(Proc::proc_filter{"sh"}));
+	EXPECT_FALSE(Proc::trigram_index::usable(Proc::proc_filter{"!spark cpu>5"}));
+	std::vector<size_t> rows;
+	EXPECT_FALSE(index.candidates(Proc::proc_filter{"sh"}, rows));
+	EXPECT_FALSE(index.candidates(Proc::proc_filter{"!spark"}, rows));
+	EXPECT_FALSE(index.candidates(Proc::proc_filter{"cpu>5"}, rows));
+
+	//? Changed and removed rows are indexed again on the next sync
+	procs[0].cmd = "/usr/bin/java -cp /opt/flink/lib Flink";
+	procs.erase(procs.begin() + 2);
+	index.sync(procs);
+	EXPECT_EQ(matching("spark"), (std::vector<size_t>{0}));
+	EXPECT_EQ(matching("flink"), (std::vector<size_t>{0}));
+	EXPECT_EQ(matching("pgsql"), (std::vector<size_t>{}));
+	EXPECT_EQ(matching("2000"), (std::vector<size_t>{2}));
+}
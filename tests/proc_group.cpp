@@ -0,0 +1,45 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include "btop_shared.hpp"
+#include "test_procs.hpp"
+
+#include <gtest/gtest.h>
+
+TEST(proc_group, sums_per_program) {
+	const std::vector<Proc::proc_info> procs{
+		test::make_proc({.pid = 300, .name = "php-fpm", .cmd = "/usr/bin/php-fpm 300", .cpu_p = 1.5, .mem = 100}),
+		test::make_proc({.pid = 20, .name = "bash", .cmd = "/usr/bin/bash 20", .mem = 10}),
+		test::make_proc({.pid = 200, .name = "php-fpm", .cmd = "/usr/bin/php-fpm 200", .cpu_p = 2.5, .mem = 200, .threads = 2}),
+		test::make_proc({.pid = 400, .name = "php-fpm", .cmd = "/usr/bin/php-fpm 400", .cpu_p = 0.5, .mem = 300}),
+	};
+	std::vector<Proc::proc_info> groups;
+	Proc::group_programs(procs, groups);
+	ASSERT_EQ(groups.size(), 2u);
+
+	const auto& php = groups[0];
+	EXPECT_EQ(php.name, std::string_view{"php-fpm"});
+	EXPECT_EQ(php.group_size, 3u);
+	EXPECT_DOUBLE_EQ(php.cpu_p, 4.5);
+	EXPECT_EQ(php.mem, 600u);
+	EXPECT_EQ(php.threads, 4u);
+	EXPECT_EQ(php.pid, 200u);
+	EXPECT_EQ(php.cmd, std::string_view{"/usr/bin/php-fpm 200"});
+
+	EXPECT_EQ(groups[1].group_size, 1u);
+	EXPECT_EQ(groups[1].pid, 20u);
+
+	//? Rebuilding replaces the previous rows
+	Proc::group_programs({}, groups);
+	EXPECT_TRUE(groups.empty());
+}
+
+TEST(proc_group, drill_down_filter) {
+	const Proc::proc_filter php{Proc::group_filter("php-fpm")};
+	EXPECT_TRUE(php(test::make_proc({.pid = 1, .name = "php-fpm"})));
+	EXPECT_FALSE(php(test::make_proc({.pid = 2, .name = "php-fpm7"})));
+	EXPECT_FALSE(php(test::make_proc({.pid = 3, .name = "xphp-fpm"})));
+
+	const Proc::proc_filter special{Proc::group_filter("postgres: writer (1)")};
+	EXPECT_TRUE(special(test::make_proc({.pid = 4, .name = "postgres: writer (1)"})));
+	EXPECT_FALSE(special(test::make_proc({.pid = 5, .name = "postgres: writer 1"})));
+}
@@ -0,0 +1,113 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include "btop_config.hpp"
+#include "btop_shared.hpp"
+
+#include <algorithm>
+#include <random>
+#include <ranges>
+
+#include <gtest/gtest.h>
+
+namespace rng = std::ranges;
+
+namespace {
+	std::vector<Proc::proc_info> make_procs(size_t count) {
+		std::mt19937 gen{count};
+		const std::vector<std::string> names{"bash", "sleep", "postgres", "postgres: writer", "kworker/0:1", "a", ""};
+		std::vector<Proc::proc_info> procs(count);
+		for (size_t i = 0; auto& proc : procs) {
+			proc.pid = 100 + i++;
+			proc.name = names[gen() % names.size()];
+			proc.cmd = proc.name.str() + (gen() % 2 ? " --flag" : "");
+			proc.user = names[gen() % 3];
+			proc.threads = gen() % 4;
+			proc.mem = (gen() % 8) << 20;
+			proc.cpu_p = gen() % 4 == 0 ? (gen() % 1000) / 10.0 : 0.0;
+			proc.cpu_c = (gen() % 100) / 10.0;
+		}
+		return procs;
+	}
+
+	//* Sorting with stable_sort over the structs, which proc_sorter must match
+	void reference_sort(std::vector<Proc::proc_info>& procs, const std::string& sorting, bool reverse, bool tree) {
+		auto sort_by = [&](auto member, bool descending) {
+			if (descending) rng::stable_sort(procs, rng::greater{}, member);
+			else rng::stable_sort(procs, rng::less{}, member);
+		};
+		if (sorting == "pid") sort_by(&Proc::proc_info::pid, not reverse);
+		else if (sorting == "name") sort_by(&Proc::proc_info::name, reverse);
+		else if (sorting == "command") sort_by(&Proc::proc_info::cmd, reverse);
+		else if (sorting == "threads") sort_by(&Proc::proc_info::threads, not reverse);
+		else if (sorting == "user") sort_by(&Proc::proc_info::user, reverse);
+		else if (sorting == "memory") sort_by(&Proc::proc_info::mem, not reverse);
+		else if (sorting == "cpu direct") sort_by(&Proc::proc_info::cpu_p, not reverse);
+		else if (sorting == "cpu lazy") sort_by(&Proc::proc_info::cpu_c, not reverse);
+
+		if (not tree and not reverse and sorting == "cpu lazy") {
+			double max = 10.0, target = 30.0;
+			for (size_t i = 0, x = 0, offset = 0; i < procs.size(); i++) {
+				if (i <= 5 and procs[i].cpu_p > max)
+					max = procs[i].cpu_p;
+				else if (i == 6)
+					target = (max > 30.0) ? max : 10.0;
+				if (i == offset and procs[i].cpu_p > 30.0)
+					offset++;
+				else if (procs[i].cpu_p > target) {
+					std::rotate(procs.begin() + offset, procs.begin() + i, procs.begin() + i + 1);
+					if (++x > 10) break;
+				}
+			}
+		}
+	}
+
+	std::vector<size_t> pids(const std::vector<Proc::proc_info>& procs, size_t count) {
+		std::vector<size_t> result;
+		for (const auto& proc : procs | std::views::take(count)) result.push_back(proc.pid);
+		return result;
+	}
+}
+
+TEST(proc_sorter, matches_stable_sort) {
+	for (const auto& sorting : Proc::sort_vector) {
+		for (const bool reverse : {false, true}) {
+			auto procs = make_procs(500);
+			auto expected = procs;
+			reference_sort(expected, sorting, reverse, false);
+			Proc::proc_sorter(procs, sorting, reverse);
+			EXPECT_EQ(pids(procs, procs.size()), pids(expected, expected.size())) << sorting << (reverse ? " reversed" : "");
+		}
+	}
+}
+
+TEST(proc_sorter, partial_limit) {
+	for (const auto& sorting : Proc::sort_vector) {
+		for (const size_t limit : {1uz, 20uz, 499uz}) {
+			auto procs = make_procs(500);
+			auto expected = procs;
+			reference_sort(expected, sorting, false, false);
+			Proc::proc_sorter(procs, sorting, false, false, limit);
+			EXPECT_EQ(pids(procs, limit), pids(expected, limit)) << sorting << " limit " << limit;
+			EXPECT_EQ(procs.size(), expected.size());
+		}
+	}
+}
+
+TEST(proc_sorter, skips_unavailable_sortings) {
+	const bool proc_io = Config::getB("proc_io"), proc_faults = Config::getB("proc_faults");
+	Config::set("proc_io", false);
+	Config::set("proc_faults", false);
+	EXPECT_FALSE(Proc::sort_available("io read"));
+	EXPECT_FALSE(Proc::sort_available("major faults"));
+	EXPECT_FALSE(Proc::sort_available("no such sorting"));
+	EXPECT_EQ(Proc::next_sorting("minor faults", -1), "cpu lazy");
+	EXPECT_EQ(Proc::next_sorting("cpu lazy", 1), "pid");
+#ifdef __linux__
+	Config::set("proc_io", true);
+	EXPECT_EQ(Proc::next_sorting("cpu lazy", 1), "io read");
+	Config::set("proc_faults", true);
+	EXPECT_EQ(Proc::next_sorting("pid", -1), "major faults");
+#endif
+	Config::set("proc_io", proc_io);
+	Config::set("proc_faults", proc_faults);
+}
@@ -0,0 +1,58 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#include "btop_shared.hpp"
+
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+TEST(shared_string, deduplicates) {
+	const auto [strings, bytes] = Proc::shared_string::table_usage();
+	{
+		Proc::shared_string a{"/usr/bin/a-unique-test-command --with arguments"};
+		Proc::shared_string b;
+		b = std::string{"/usr/bin/a-unique-test-command --with arguments"};
+		EXPECT_EQ(a, b);
+		EXPECT_EQ(&a.str(), &b.str());
+		EXPECT_EQ(Proc::shared_string::table_usage().first, strings + 1);
+
+		Proc::shared_string c = a;
+		a = "another";
+		EXPECT_EQ(c, b);
+		EXPECT_EQ(a, std::string_view{"another"});
+		EXPECT_EQ(Proc::shared_string::table_usage().first, strings + 2);
+	}
+	EXPECT_EQ(Proc::shared_string::table_usage(), std::make_pair(strings, bytes));
+}
+
+TEST(shared_string, empty) {
+	Proc::shared_string a{""};
+	EXPECT_TRUE(a.empty());
+	EXPECT_EQ(a, Proc::shared_string{});
+	EXPECT_EQ(a.str(), "");
+	a = "x";
+	EXPECT_FALSE(a.empty());
+	a = "";
+	EXPECT_TRUE(a.empty());
+}
+
+TEST(shared_string, concurrent_handles) {
+	const auto [strings, bytes] = Proc::shared_string::table_usage();
+	{
+		const Proc::shared_string shared{"a-shared-test-string"};
+		std::vector<std::jthread> threads;
+		for (int t = 0; t < 4; t++) {
+			threads.emplace_back([&shared] {
+				for (int i = 0; i < 10000; i++) {
+					Proc::shared_string copy = shared;
+					Proc::shared_string other{"a-contended-test-string"};
+					Proc::shared_string moved = std::move(copy);
+				}
+			});
+		}
+		threads.clear();
+		EXPECT_EQ(Proc::shared_string::table_usage().first, strings + 1);
+	}
+	EXPECT_EQ(Proc::shared_string::table_usage(), std::make_pair(strings, bytes));
+}
@@ -0,0 +1,34 @@
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include "btop_shared.hpp"
+
+#include <string>
+
+namespace test {
+	//* Fields the tests set on a process, filled with designated initializers
+	struct proc_fields {
+		size_t pid{};
+		std::string name{};
+		std::string cmd{};
+		std::string user{};
+		double cpu_p{};
+		uint64_t mem{};
+		size_t threads{1};
+		uint64_t cpu_s{1};
+	};
+
+	inline Proc::proc_info make_proc(proc_fields fields) {
+		Proc::proc_info proc{};
+		proc.pid = fields.pid;
+		proc.name = std::move(fields.name);
+		proc.cmd = std::move(fields.cmd);
+		proc.user = std::move(fields.user);
+		proc.cpu_p = fields.cpu_p;
+		proc.mem = fields.mem;
+		proc.threads = fields.threads;
+		proc.cpu_s = fields.cpu_s;
+		return proc;
+	}
+}